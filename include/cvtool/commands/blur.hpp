@@ -10,6 +10,8 @@ struct BlurOptions
 {
     std::string in_path, out_path;
     int blur_k{0};
+    int strip_rows{0}; // > 0: process in parallel strips of this many rows
+    bool quiet{false}; // batch mode: no per-image report
 };
 
 }
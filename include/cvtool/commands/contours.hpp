@@ -2,8 +2,14 @@
 
 #include "cvtool/core/exit_codes.hpp"
 
+#include <memory>
 #include <string>
 
+namespace cvtool::core::threshold
+{
+class OtsuState;
+}
+
 namespace cvtool::cmd
 {
 
@@ -18,10 +24,21 @@ struct ContoursOptions {
 
     int block{11};
     double c{2.0};
+    double k{0.2}; // sauvola
+    double p{15.0}; // bradley, percent below the window mean
 
     int t{-1};
 
+    int otsu_classes{2}; // > 2: multi-level Otsu, the mask keeps the brightest class
+    int otsu_sample{1}; // histogram from every N-th row and column
+    double otsu_smoothing{0.0}; // batch mode: weight of each new image in the carried histogram
+    std::shared_ptr<cvtool::core::threshold::OtsuState> otsu_state; // shared across a batch run
+
     std::string json_path{};
+    std::string json_format{"pretty"}; // pretty | compact | ndjson
+    std::string bin_path{}; // columnar report (.cvcol)
+    bool stats_only{false}; // connected components: pixel areas and bboxes, no polygons
+    bool quiet{false}; // batch mode: no per-image report
 };
 
 }
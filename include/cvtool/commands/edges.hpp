@@ -12,6 +12,8 @@ struct EdgesOptions {
     int blur_k{0};
     int threshold_low{0};
     int threshold_high{0};
+    int strip_rows{0}; // > 0: process in parallel strips of this many rows
+    bool quiet{false}; // batch mode: no per-image report
 };
 
 }
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+
+#include <string>
+
+namespace cvtool::cmd {
+
+struct GestureReplayOptions
+{
+    std::string in_path;
+    std::string rules_path;
+    bool enable_contextual_gestures{false};
+    int stable_frames{5};
+    int cooldown_ms{300};
+    int repeat{1};
+    bool quiet{false};
+};
+
+}
+
+cvtool::core::ExitCode run_gesture_replay(const cvtool::cmd::GestureReplayOptions &opt);
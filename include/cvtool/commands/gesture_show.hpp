@@ -9,16 +9,30 @@ namespace cvtool::cmd {
 struct GestureShowOptions
 {
     int cam{0};
+    std::string in_path;
+    bool headless{false};
+    std::string latency_out_path;
+    std::string record_path;
     std::string map_path;
+    std::string rules_path;
+    int bank_cache_mb{0};
     std::string size_str;
     bool mirror{false};
     std::string roi;
     bool show_debug{false};
     std::string hand_model_path;
+    int warmup_runs{2};
     int stable_frames{5};
     int cooldown_ms{300};
+    int hand_interval{2};
+    int max_hands{1};
+    int discovery_interval{10};
+    bool smooth{false};
+    float smooth_min_cutoff{1.0f};
+    float smooth_beta{0.05f};
     std::string face_model_path;
     float face_min_confidence{0.5f};
+    int face_input_size{640};
     bool enable_contextual_gestures{false};
 };
 
@@ -9,6 +9,8 @@ namespace cvtool::cmd {
 struct GrayOptions { 
     std::string in_path; 
     std::string out_path; 
+    int strip_rows{0}; // > 0: process in parallel strips of this many rows
+    bool quiet{false}; // batch mode: no per-image report
 };
 
 }
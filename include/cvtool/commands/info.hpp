@@ -6,7 +6,10 @@
 
 namespace cvtool::cmd {
 
-struct InfoOptions { std::string in_path; };
+struct InfoOptions {
+    std::string in_path;
+    bool json{false}; // one JSON object per line instead of key: value text
+};
 
 }
 
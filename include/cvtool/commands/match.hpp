@@ -18,6 +18,8 @@ struct MatchOptions
     std::string mode{"gray"};
     std::string heatmap_path;
     std::string json_path;
+    std::string json_format{"pretty"}; // pretty | compact | ndjson
+    std::string bin_path; // columnar report (.cvcol)
     
     std::string roi{};
     std::string draw{"bbox+label+score"};
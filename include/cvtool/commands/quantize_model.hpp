@@ -0,0 +1,23 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+
+#include <string>
+
+namespace cvtool::cmd {
+
+struct QuantizeModelOptions
+{
+    std::string frames_dir;
+    std::string out_dir;
+    std::string hand_model_path;
+    std::string face_model_path;
+    std::string int8_hand_model_path;
+    std::string int8_face_model_path;
+    int face_input_size{640};
+    int max_frames{200};
+};
+
+}
+
+cvtool::core::ExitCode run_quantize_model(const cvtool::cmd::QuantizeModelOptions &opt);
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+
+#include <string>
+#include <vector>
+
+namespace cvtool::cmd {
+
+struct ThresholdBenchOptions
+{
+    std::string in_path;
+    std::vector<int> blocks{11, 51, 101, 151};
+    double c{2.0};
+    double k{0.2};
+    double p{15.0};
+    int repeat{5};
+};
+
+}
+
+cvtool::core::ExitCode run_threshold_bench(const cvtool::cmd::ThresholdBenchOptions &opt);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+
+#include <functional>
+#include <string>
+
+namespace cvtool::core
+{
+
+struct BatchOptions
+{
+    std::string in_dir;        // every image below this folder
+    std::string manifest_path; // or: one input path per line
+    std::string out_dir;       // outputs mirror the input layout below this folder
+    std::string out_ext;       // e.g. ".png"; empty = keep the input extension
+    std::string checkpoint_path;
+    int jobs{0};               // 0 = hardware concurrency
+
+    bool active() const { return !in_dir.empty() || !manifest_path.empty(); }
+};
+
+using BatchJob = std::function<cvtool::core::ExitCode(const std::string &in_path, const std::string &out_path)>;
+
+// Runs job for every input on a pool of worker threads; each worker reads, processes
+// and writes its own image, so decoding, processing and encoding of different images overlap.
+// Finished inputs are appended to the checkpoint file and skipped when it is reused.
+cvtool::core::ExitCode run_batch(const std::string &command, const BatchOptions &opt, const BatchJob &job);
+
+}
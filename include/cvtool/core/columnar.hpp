@@ -0,0 +1,143 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+#include "cvtool/core/mapped_file.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cvtool::core::columnar
+{
+
+// Columnar result file (.cvcol), little-endian:
+//   FileHeader
+//   TableHeader[table_count]
+//   ColumnHeader[sum of column_count]
+//   column data, each column contiguous (row_count values) and 64-byte aligned
+// A reader maps the file and uses every column in place as a plain array.
+constexpr std::array<char, 4> columnar_magic{'C', 'V', 'C', 'T'};
+constexpr std::uint32_t columnar_version{1};
+constexpr std::size_t columnar_alignment{64};
+
+enum class ColumnType : std::uint32_t
+{
+    Int32 = 1,
+    Float32 = 2,
+    Float64 = 3
+};
+
+struct FileHeader
+{
+    std::array<char, 4> magic{columnar_magic};
+    std::uint32_t version{columnar_version};
+    std::uint32_t table_count{0};
+    std::uint32_t reserved{0};
+};
+
+struct TableHeader
+{
+    std::array<char, 16> name{}; // NUL-padded
+    std::uint64_t row_count{0};
+    std::uint32_t column_count{0};
+    std::uint32_t first_column{0}; // index into the column headers
+};
+
+struct ColumnHeader
+{
+    std::array<char, 16> name{}; // NUL-padded
+    ColumnType type{ColumnType::Int32};
+    std::uint32_t value_size{0};
+    std::uint64_t offset{0}; // from the start of the file
+};
+
+static_assert(sizeof(FileHeader) == 16);
+static_assert(sizeof(TableHeader) == 32);
+static_assert(sizeof(ColumnHeader) == 32);
+
+template <class T>
+constexpr ColumnType column_type_of()
+{
+    static_assert(std::is_same_v<T, std::int32_t> || std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "columns hold int32, float or double");
+
+    if constexpr (std::is_same_v<T, std::int32_t>)
+        return ColumnType::Int32;
+    else if constexpr (std::is_same_v<T, float>)
+        return ColumnType::Float32;
+    else
+        return ColumnType::Float64;
+}
+
+// A table to write. Rows usually live in a vector of structs, so each column is
+// described by a getter and gathered through a small fixed buffer when written.
+struct Table
+{
+    struct Column
+    {
+        std::string name;
+        ColumnType type{ColumnType::Int32};
+        std::uint32_t value_size{0};
+        std::function<void(std::size_t row, unsigned char *dst)> get;
+    };
+
+    std::string name;
+    std::size_t rows{0};
+    std::vector<Column> columns;
+
+    template <class T, class Fn>
+    void add_column(const std::string &column_name, Fn fn)
+    {
+        columns.push_back({column_name, column_type_of<T>(), sizeof(T),
+                           [fn](std::size_t row, unsigned char *dst)
+                           {
+                               const T v = static_cast<T>(fn(row));
+                               std::memcpy(dst, &v, sizeof(T));
+                           }});
+    }
+};
+
+cvtool::core::ExitCode write_columnar(const std::string &path, const std::vector<Table> &tables, std::string &err);
+
+struct ColumnView
+{
+    std::string name;
+    ColumnType type{ColumnType::Int32};
+    const void *data{nullptr};
+
+    template <class T>
+    const T *as() const { return type == column_type_of<T>() ? static_cast<const T *>(data) : nullptr; }
+};
+
+struct TableView
+{
+    std::string name;
+    std::size_t rows{0};
+    std::vector<ColumnView> columns;
+
+    const ColumnView *column(const std::string &column_name) const;
+};
+
+// Maps a .cvcol file; the views point into the mapping and stay valid while the reader lives.
+class ColumnarReader
+{
+private:
+    cvtool::core::MappedFile file_;
+    std::vector<TableView> tables_;
+
+public:
+    cvtool::core::ExitCode open(const std::string &path, std::string &err);
+
+    const std::vector<TableView> &tables() const { return tables_; }
+    const TableView *table(const std::string &table_name) const;
+};
+
+// True when the buffer starts like a .cvcol file.
+bool is_columnar(const unsigned char *data, std::size_t size);
+
+}
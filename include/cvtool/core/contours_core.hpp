@@ -37,4 +37,14 @@ cvtool::core::ExitCode find_contours_report(
     std::string &err
 );
 
+// Statistics-only variant: every 8-connected blob of the mask is one item, area is
+// its pixel count and no polygons are built (items[i].contour stays empty).
+cvtool::core::ExitCode find_components_report(
+    const cv::Mat &bin,
+    double min_area,
+    std::vector<ContourItem> &items,
+    ContourStats &stats,
+    std::string &err
+);
+
 }
@@ -27,4 +27,18 @@ cvtool::core::ExitCode edges_frame_to_gray(
     std::string &err
 );
 
+// Same result as edges_frame_to_gray, computed in parallel strips of strip_rows rows so the
+// gray, blur and gradient buffers never exist at full size. Each strip yields its Canny
+// candidates (cv::Canny(low, low)) and seeds (cv::Canny(high, high)); the hysteresis that
+// links candidates to seeds across strips runs once on the assembled map.
+cvtool::core::ExitCode edges_frame_to_gray_in_strips(
+    const cv::Mat &frame,
+    int low,
+    int high,
+    int blur_k,
+    int strip_rows,
+    cv::Mat &out_gray,
+    std::string &err
+);
+
 }
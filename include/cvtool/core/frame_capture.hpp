@@ -0,0 +1,87 @@
+#pragma once
+
+#include <opencv2/core/mat.hpp>
+#include <opencv2/videoio.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cvtool::core
+{
+
+struct CapturedFrame
+{
+    cv::Mat image;
+    std::uint64_t seq{0};
+    std::chrono::steady_clock::time_point captured_at{};
+};
+
+struct CaptureStats
+{
+    double fps{0.0};
+    std::uint64_t captured{0};
+    std::uint64_t dropped{0};
+};
+
+enum class CaptureStatus
+{
+    Frame,
+    Timeout,
+    End
+};
+
+// Reads a cv::VideoCapture on its own thread into a fixed ring of frame slots.
+// Live sources overwrite the oldest unread frame when the consumer lags;
+// file sources block instead, so every frame is delivered.
+// Frame buffers are swapped between the ring and the consumer, never copied.
+class FrameCapture
+{
+private:
+    cv::VideoCapture &cap_;
+    bool drop_oldest_{true};
+    int max_read_failures_{15};
+
+    std::vector<CapturedFrame> slots_;
+    std::size_t head_{0}; // next slot to read from
+    std::size_t count_{0};
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    bool stop_{false};
+    bool ended_{false};
+    bool failed_{false};
+
+    CaptureStats stats_{};
+    std::chrono::steady_clock::time_point fps_window_start_{};
+    std::uint64_t fps_window_frames_{0};
+
+    std::thread worker_;
+
+    void run();
+
+public:
+    FrameCapture(cv::VideoCapture &cap, std::size_t slots, bool drop_oldest, int max_read_failures = 15);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture &) = delete;
+    FrameCapture &operator=(const FrameCapture &) = delete;
+
+    void start();
+    void stop();
+
+    // Waits up to timeout for the oldest unread frame and swaps it into out.
+    // Returns End once the source is exhausted (or dead) and the ring is drained.
+    CaptureStatus next(CapturedFrame &out, std::chrono::milliseconds timeout);
+
+    // True when the source ended because of repeated read failures.
+    bool failed() const;
+
+    CaptureStats stats() const;
+};
+
+}
@@ -3,6 +3,9 @@
 #include "cvtool/core/gesture/gesture_domain.hpp"
 #include "cvtool/core/gesture/face_landmarks.hpp"
 #include "cvtool/core/gesture/hand_landmarks.hpp"
+#include "cvtool/core/gesture/gesture_batch.hpp"
+
+#include <cstdint>
 
 namespace cvtool::core::gesture
 {
@@ -11,5 +14,13 @@ GestureID classify_contextual_gesture(
     const HandLandmarkResult &hand_data,
     const FaceLandmarkResult &face_data);
 
+// out_gestures[i] = classify_contextual_gesture(hands.at(i), faces.at(i)); faces.size() must match.
+// finger_masks (from extract_finger_state_batch) is optional and saves recomputing them.
+void classify_contextual_gesture_batch(
+    const HandLandmarkBatch &hands,
+    const FaceLandmarkBatch &faces,
+    GestureID *out_gestures,
+    const std::uint8_t *finger_masks = nullptr);
+
 
 }
\ No newline at end of file
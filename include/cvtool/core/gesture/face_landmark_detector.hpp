@@ -2,6 +2,7 @@
 
 #include "cvtool/core/exit_codes.hpp"
 #include "cvtool/core/gesture/face_landmarks.hpp"
+#include "cvtool/core/gesture/onnx_model.hpp"
 
 #include <onnxruntime/onnxruntime_cxx_api.h>
 
@@ -27,21 +28,36 @@ private:
     bool initialized_{false};
     std::string last_error_;
     float min_face_score_{0.5f};
-    int input_width_{640};
-    int input_height_{640};
+    int input_size_{640};
     std::array<int64_t, 4> input_shape_{1, 3, 640, 640};
+    static constexpr std::array<int, 3> strides_{8, 16, 32};
 
-    cv::Mat preprocess_image(const cv::Mat &frame);
-    Ort::Value create_input_tensor(cv::Mat &blob);
+    cv::Mat canvas_;
+    cv::Size canvas_content_{};
+    std::vector<float> input_buffer_;
+    ModelLoadTimings load_timings_{};
+
+    // Letterboxed into the top-left corner of an input_size_ x input_size_ square.
+    void preprocess_image(const cv::Mat &frame, float &scale);
+    Ort::Value create_input_tensor();
     cvtool::core::gesture::FaceLandmarkResult decode_output(
-        std::vector<Ort::Value> &out_tensor, const cv::Mat &frame, const cv::Rect &roi
+        std::vector<Ort::Value> &out_tensor, const cv::Mat &frame, const cv::Rect &roi, float scale
     );
 
 
 public:
-    cvtool::core::ExitCode initialize(const std::string &model_path, std::string &err);
+    static constexpr std::array<int, 3> supported_input_sizes{320, 480, 640};
+
+    cvtool::core::ExitCode initialize(const std::string &model_path, std::string &err, int input_size = 640);
 
     FaceLandmarkResult detect(const cv::Mat &frame, const cv::Rect &roi = cv::Rect());
+
+    // Runs the session on zero tensors so the first real frames do not pay for ORT's lazy initialization.
+    cvtool::core::ExitCode warm_up(int runs, std::string &err);
+
+    const ModelLoadTimings &load_timings() const { return load_timings_; }
+
+    cv::Mat input_blob(const cv::Mat &frame, const cv::Rect &roi = cv::Rect());
 };
 
 }
\ No newline at end of file
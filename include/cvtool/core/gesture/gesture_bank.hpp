@@ -6,6 +6,7 @@
 #include <opencv2/core.hpp>
 
 #include <functional>
+#include <list>
 #include <unordered_map>
 #include <string>
 #include <filesystem>
@@ -23,20 +24,37 @@ struct TransparentStringHash
     }
 };
 
+struct GestureBankOptions
+{
+    cv::Size display_size{};     // images are letterboxed to this size at load time (empty = as decoded)
+    std::size_t max_bytes{0};    // 0 = decode everything up front; otherwise decode on first use, LRU-bounded
+    unsigned threads{0};         // decoder threads for the up-front load (0 = hardware concurrency)
+};
+
 struct GestureImageBank
 {
     std::filesystem::path base_dir;
     std::unordered_map<std::string, cv::Mat, TransparentStringHash, std::equal_to<>> images;
     cv::Mat fallback;
+
+    // lazy mode
+    cv::Size display_size{};
+    std::size_t max_bytes{0};
+    std::size_t cached_bytes{0};
+    std::unordered_map<std::string, std::filesystem::path, TransparentStringHash, std::equal_to<>> paths;
+    std::list<std::string> lru; // most recently shown first
 };
 
 cvtool::core::ExitCode load_gesture_image_bank(
     const std::string &map_path,
     GestureImageBank &out_bank,
     std::vector<std::string> &warnings,
-    std::string &err
+    std::string &err,
+    const GestureBankOptions &options = {}
 );
 
-const cv::Mat &get_gesture_image(const GestureImageBank &bank, cvtool::core::gesture::GestureID id);
+// Ready to show: a Mat header copy of the result is all the caller needs.
+// In lazy mode the image is decoded on first use and may evict older ones.
+const cv::Mat &get_gesture_image(GestureImageBank &bank, cvtool::core::gesture::GestureID id);
 
 }
\ No newline at end of file
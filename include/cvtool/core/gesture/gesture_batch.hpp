@@ -0,0 +1,49 @@
+#pragma once
+
+#include "cvtool/core/gesture/face_landmarks.hpp"
+#include "cvtool/core/gesture/hand_landmarks.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace cvtool::core::gesture
+{
+
+// Structure-of-arrays view of many hand results for offline classification:
+// x[k][i] / y[k][i] is landmark k of sample i, so the batch classifiers can
+// process consecutive samples with vector loads.
+struct HandLandmarkBatch
+{
+    std::array<std::vector<float>, 21> x;
+    std::array<std::vector<float>, 21> y;
+    std::vector<float> confidence;
+    std::vector<std::uint8_t> has_hand;
+
+    std::size_t size() const { return confidence.size(); }
+
+    void reserve(std::size_t n);
+    void clear();
+    void push_back(const HandLandmarkResult &hand);
+    HandLandmarkResult at(std::size_t i) const;
+};
+
+// The face fields the contextual rules read, one entry per hand sample.
+struct FaceLandmarkBatch
+{
+    std::vector<std::uint8_t> has_face;
+    std::vector<float> confidence;
+    std::vector<float> bbox_w;
+    std::vector<float> bbox_h;
+    std::vector<float> mouth_x;
+    std::vector<float> mouth_y;
+
+    std::size_t size() const { return confidence.size(); }
+
+    void reserve(std::size_t n);
+    void clear();
+    void push_back(const FaceLandmarkResult &face);
+    FaceLandmarkResult at(std::size_t i) const;
+};
+
+}
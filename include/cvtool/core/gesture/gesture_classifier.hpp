@@ -0,0 +1,20 @@
+#pragma once
+
+#include "cvtool/core/gesture/gesture_rules.hpp"
+#include "cvtool/core/gesture/gesture_rule_table.hpp"
+#include "cvtool/core/gesture/face_landmarks.hpp"
+#include "cvtool/core/gesture/hand_landmarks.hpp"
+
+namespace cvtool::core::gesture
+{
+
+// The per-frame classification gesture-show runs before the stabilizer:
+// the rule table when given, otherwise the built-in rules with the contextual
+// gestures overriding Unknown / Fist. The hand must pass can_classify_hand.
+ClassifierResult classify_gesture(
+    const HandLandmarkResult &hand,
+    const FaceLandmarkResult &face,
+    bool contextual,
+    const GestureRuleTable *rules);
+
+}
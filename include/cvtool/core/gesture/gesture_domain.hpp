@@ -6,7 +6,7 @@ namespace cvtool::core::gesture
 {
 
 
-enum class GestureID
+enum class GestureID : int
 {
     None,
     OpenPalm,
@@ -21,6 +21,12 @@ std::string_view to_asset_key(GestureID id);
 
 std::string_view to_debug_label(GestureID id);
 
+// Gestures defined at runtime (rules file) get IDs after GestureID::Unknown.
+// Registering an existing asset key returns its ID. Not thread-safe: register at startup.
+GestureID register_gesture(std::string_view asset_key, std::string_view debug_label = {});
+
+bool find_gesture(std::string_view asset_key, GestureID &out_id);
+
 
 
 }
\ No newline at end of file
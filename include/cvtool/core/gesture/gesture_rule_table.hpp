@@ -0,0 +1,61 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+#include "cvtool/core/gesture/gesture_domain.hpp"
+#include "cvtool/core/gesture/gesture_rules.hpp"
+#include "cvtool/core/gesture/face_landmarks.hpp"
+#include "cvtool/core/gesture/hand_landmarks.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cvtool::core::gesture
+{
+
+enum class RuleOp : std::uint8_t
+{
+    AboveY,       // points[a].y < points[b].y
+    BelowY,       // points[a].y > points[b].y
+    DistLt,       // distance(a, b) / palm_scale < value
+    DistGt,       // distance(a, b) / palm_scale > value
+    FaceConfGe,   // face.confidence >= value
+    MouthDistLt,  // distance(a, mouth_center) / max(face w, h) < value
+    MouthDxLt,    // |a.x - mouth_center.x| / face w < value
+    MouthDyLt     // |a.y - mouth_center.y| / face h < value
+};
+
+struct RuleInstr
+{
+    RuleOp op{RuleOp::AboveY};
+    std::uint8_t a{0};
+    std::uint8_t b{0};
+    float value{0.0f};
+};
+
+struct CompiledRule
+{
+    GestureID id{GestureID::Unknown};
+    bool needs_face{false};
+    std::vector<RuleInstr> code; // all instructions must hold
+};
+
+// 5-bit finger state (finger_mask) -> candidate rules in file order.
+struct GestureRuleTable
+{
+    std::vector<CompiledRule> rules;
+    std::array<std::vector<std::uint16_t>, 32> lut;
+};
+
+// Registers every gesture named in the file (see register_gesture) and compiles the table.
+cvtool::core::ExitCode load_gesture_rules(const std::string &rules_path, GestureRuleTable &out_table, std::string &err);
+
+// Rules that need a face are skipped when use_face is false or no face is present.
+ClassifierResult classify_with_rules(
+    const GestureRuleTable &table,
+    const HandLandmarkResult &hand,
+    const FaceLandmarkResult &face,
+    bool use_face);
+
+}
@@ -2,6 +2,9 @@
 
 #include "cvtool/core/gesture/gesture_domain.hpp"
 #include "cvtool/core/gesture/hand_landmarks.hpp"
+#include "cvtool/core/gesture/gesture_batch.hpp"
+
+#include <cstdint>
 
 namespace cvtool::core::gesture
 {
@@ -16,6 +19,16 @@ enum HandLandmarkIndex
     PinkyMcp, PinkyPip, PinkyDip, PinkyTip
 };
 
+// Bit of each finger in a finger mask, in landmark order.
+enum FingerBit : std::uint8_t
+{
+    ThumbBit = 1,
+    IndexBit = 2,
+    MiddleBit = 4,
+    RingBit = 8,
+    PinkyBit = 16
+};
+
 struct FingerState
 {
     bool thumb_extended{false};
@@ -38,10 +51,26 @@ float compute_palm_scale(const cvtool::core::gesture::HandLandmarkResult &data);
 
 FingerState extract_finger_state(const HandLandmarkResult &data);
 
+std::uint8_t finger_mask(const FingerState &state);
+
+// The built-in gesture rules, shared by classify_hand_gesture and the batch
+// classifier. thumb_up only matters for masks whose gesture needs it (thumbs up).
+GestureID builtin_gesture(std::uint8_t finger_mask, bool thumb_up);
+
 bool can_classify_hand(const HandLandmarkResult &data);
 
 ClassifierResult classify_hand_gesture(const HandLandmarkResult &data);
 
+// Batch versions over hands.size() samples, four samples per SIMD step.
+// out_masks[i] is extract_finger_state(hands.at(i)) as bits (see FingerBit and finger_mask).
+void extract_finger_state_batch(const HandLandmarkBatch &hands, std::uint8_t *out_masks);
+
+// out_ok[i] = can_classify_hand(hands.at(i)) ? 1 : 0
+void can_classify_hand_batch(const HandLandmarkBatch &hands, std::uint8_t *out_ok);
+
+// out_gestures[i] = classify_hand_gesture(hands.at(i)).gesture; out_masks is optional.
+void classify_hand_gesture_batch(const HandLandmarkBatch &hands, GestureID *out_gestures, std::uint8_t *out_masks = nullptr);
+
 
 
 }
\ No newline at end of file
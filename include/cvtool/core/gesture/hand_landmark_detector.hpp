@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cvtool/core/gesture/hand_landmarks.hpp"
+#include "cvtool/core/gesture/onnx_model.hpp"
 #include "cvtool/core/exit_codes.hpp"
 
 #include <onnxruntime/onnxruntime_cxx_api.h>
@@ -13,6 +14,12 @@
 
 namespace cvtool::core::gesture
 {
+    struct HandCrop
+    {
+        cv::Mat frame;
+        cv::Rect roi{}; // empty = whole frame
+    };
+
     class HandLandmarkDetector
     {
     private:
@@ -23,6 +30,8 @@ namespace cvtool::core::gesture
         std::string last_error_{};
         float min_hand_score_{0.5f}; // hand detection confidence threshold
         int tight_miss_streak_{0};
+        bool dynamic_batch_{false};
+        ModelLoadTimings load_timings_{};
 
         int input_width_{224};
         int input_height_{224};
@@ -30,14 +39,36 @@ namespace cvtool::core::gesture
         std::array<const char*, 1> input_names_{"input"};
         std::array<const char*, 3> output_names_{"xyz_x21", "hand_score", "lefthand_0_or_righthand_1"};
 
-        cv::Mat preprocess_image(const cv::Mat &frame);
-        Ort::Value create_input_tensor(const cv::Mat &blob);
+        cv::Mat resize_buffer_;
+        std::vector<float> input_buffer_; // N x 3 x H x W, reused across calls
+
+        void preprocess_image(const std::vector<cv::Mat> &crops);
+        Ort::Value create_input_tensor(std::size_t batch);
         cvtool::core::gesture::HandLandmarkResult decode_output(
-            std::vector<Ort::Value> &out_tensor, const cv::Mat &frame, const cv::Rect &roi);
+            std::vector<Ort::Value> &out_tensor, std::size_t index, std::size_t batch,
+            const cv::Mat &frame, const cv::Rect &roi);
+        std::vector<cvtool::core::gesture::HandLandmarkResult> run_batch(const std::vector<HandCrop> &crops);
 
     public:
         cvtool::core::ExitCode initialize(const std::string &model_path, std::string &err);
         cvtool::core::gesture::HandLandmarkResult detect(const cv::Mat &frame, const cv::Rect &roi = cv::Rect());
+
+        // One session Run for all crops when the model has a dynamic batch dimension,
+        // one Run per crop otherwise. Results keep the order of the crops.
+        std::vector<cvtool::core::gesture::HandLandmarkResult> detect_batch(const std::vector<HandCrop> &crops);
+        std::vector<cvtool::core::gesture::HandLandmarkResult> detect_batch(
+            const cv::Mat &frame, const std::vector<cv::Rect> &rois);
+
+        bool supports_batching() const { return dynamic_batch_; }
+
+        // Runs the session on zero tensors so ORT's lazy allocations and kernel selection
+        // happen at startup instead of on the first frames. batch > 1 also primes the batched shape.
+        cvtool::core::ExitCode warm_up(int runs, std::string &err, std::size_t batch = 1);
+
+        const ModelLoadTimings &load_timings() const { return load_timings_; }
+
+        // Exactly the tensor detect() feeds the model, for calibration / offline evaluation.
+        cv::Mat input_blob(const cv::Mat &frame, const cv::Rect &roi = cv::Rect());
     };
 
 }
\ No newline at end of file
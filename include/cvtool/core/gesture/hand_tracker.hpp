@@ -0,0 +1,90 @@
+#pragma once
+
+#include "cvtool/core/gesture/hand_landmarks.hpp"
+#include "cvtool/core/gesture/hand_landmark_detector.hpp"
+#include "cvtool/core/gesture/gesture_rules.hpp"
+#include "cvtool/core/gesture/gesture_stabilizer.hpp"
+#include "cvtool/core/gesture/landmark_filter.hpp"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <vector>
+
+namespace cvtool::core::gesture
+{
+
+struct HandTrackerConfig
+{
+    int max_hands{2};
+    int stable_frames{5};
+    int cooldown_ms{300};
+    bool smooth{false};
+    float smooth_min_cutoff{1.0f};
+    float smooth_beta{0.05f};
+    int max_missed{3};        // inference frames a track may miss before it is dropped
+    float match_iou{0.3f};    // a new detection overlapping a track by more than this belongs to it
+    float duplicate_iou{0.5f}; // two tracks overlapping by more than this follow the same hand
+    int discovery_interval{10}; // inference frames between searches for more hands while one is tracked
+};
+
+struct HandTrack
+{
+    int id{0};
+    HandLandmarkResult hand{};
+    cv::Rect search_bbox{};   // last confirmed hand box, the next tracking crop is built around it
+    bool updated{false};      // inference ran for this track on the current frame
+    bool predicted{false};    // landmarks come from the filter, not from the model
+    int missed{0};
+
+    GestureStabilizer stabilizer;
+    LandmarkFilter filter;
+    ClassifierResult raw_gesture{GestureID::None};
+    StabilizerResult stab_res{};
+
+    HandTrack(int track_id, const HandTrackerConfig &cfg)
+        : id(track_id),
+          stabilizer(cfg.stable_frames, cfg.cooldown_ms),
+          filter(cfg.smooth_min_cutoff, cfg.smooth_beta)
+        {}
+};
+
+// Keeps up to max_hands hands across frames. Every inference frame runs one batched
+// detector call with one crop around each live track. Discovery crops are added
+// while there is room for more hands: the whole area when nothing is tracked,
+// otherwise the left/right halves without a tracked hand, every
+// discovery_interval inference frames or right after a track lost its hand.
+class HandTracker
+{
+private:
+    HandTrackerConfig cfg_;
+    std::vector<HandTrack> tracks_;
+    int next_id_{1};
+    int frames_since_discovery_{0};
+
+    void apply_detection(HandTrack &track, const HandLandmarkResult &detection,
+                         std::chrono::steady_clock::time_point time_now);
+
+public:
+    explicit HandTracker(const HandTrackerConfig &cfg) : cfg_(cfg)
+        {
+            if (cfg_.max_hands < 1) cfg_.max_hands = 1;
+            if (cfg_.max_missed < 0) cfg_.max_missed = 0;
+            if (cfg_.discovery_interval < 1) cfg_.discovery_interval = 1;
+        }
+
+    // roi: search area in frame coordinates (empty = whole frame).
+    // Without inference the tracks are only extrapolated (when smoothing is on).
+    void update(HandLandmarkDetector &detector, const cv::Mat &frame, const cv::Rect &roi,
+                bool run_inference, std::chrono::steady_clock::time_point time_now);
+
+    std::vector<HandTrack> &tracks() { return tracks_; }
+    const std::vector<HandTrack> &tracks() const { return tracks_; }
+
+    // True while a track lost its hand and should be looked for again on the next frame.
+    bool needs_inference() const;
+
+    void reset();
+};
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "cvtool/core/gesture/hand_landmarks.hpp"
+
+#include <array>
+#include <chrono>
+
+namespace cvtool::core::gesture
+{
+
+// One-Euro filter (Casiez et al.) over the 21 hand landmarks, one filter per coordinate.
+// min_cutoff [Hz] sets the jitter removal at rest, beta how quickly the cutoff opens up with speed.
+class LandmarkFilter
+{
+private:
+    float min_cutoff_{1.0f};
+    float beta_{0.05f};
+    float d_cutoff_{1.0f};
+    std::chrono::milliseconds max_predict_{100};
+
+    bool has_state_{false};
+    std::chrono::steady_clock::time_point last_time_{};
+    std::array<cv::Point2f, 21> position_{};
+    std::array<cv::Point2f, 21> velocity_{}; // px per second
+    HandLandmarkResult last_{};
+
+public:
+    LandmarkFilter(float min_cutoff, float beta, float d_cutoff = 1.0f)
+        : min_cutoff_(min_cutoff),
+          beta_(beta),
+          d_cutoff_(d_cutoff)
+        {
+            if (min_cutoff_ <= 0.0f) min_cutoff_ = 1.0f;
+            if (beta_ < 0.0f) beta_ = 0.0f;
+            if (d_cutoff_ <= 0.0f) d_cutoff_ = 1.0f;
+        }
+
+    // Filters a fresh detection. A result without a hand resets the filter and is returned as is.
+    HandLandmarkResult update(const HandLandmarkResult &raw, std::chrono::steady_clock::time_point time_now);
+
+    // Extrapolates the last filtered landmarks to time_now (capped at 100 ms ahead)
+    // so frames without inference can still be classified.
+    HandLandmarkResult predict(std::chrono::steady_clock::time_point time_now) const;
+
+    bool has_state() const { return has_state_; }
+
+    void reset();
+};
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+#include "cvtool/core/gesture/face_landmarks.hpp"
+#include "cvtool/core/gesture/hand_landmarks.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cvtool::core::gesture
+{
+
+// Landmark recording (.cvlm): a 16-byte header followed by fixed-size records,
+// little-endian, no padding between records, so a file can also be memory-mapped
+// and indexed directly. Every record holds what the classifier saw on one frame.
+constexpr std::array<char, 4> landmark_record_magic{'C', 'V', 'L', 'M'};
+constexpr std::uint32_t landmark_record_version{1};
+constexpr int landmark_record_max_hands{4};
+
+struct LandmarkRecordHeader
+{
+    std::array<char, 4> magic{landmark_record_magic};
+    std::uint32_t version{landmark_record_version};
+    std::uint32_t record_size{0};
+    std::uint32_t max_hands{1}; // --max-hands of the recording session (1 = single-hand path)
+};
+
+struct RecordedHand
+{
+    std::int32_t track_id{-1}; // -1 in single-hand mode
+    std::uint8_t has_hand{0};
+    std::uint8_t handedness{static_cast<std::uint8_t>(Handedness::None)};
+    std::uint8_t updated{0};   // fresh detection this frame
+    std::uint8_t predicted{0}; // extrapolated by the landmark filter this frame
+    float confidence{0.0f};
+    std::array<float, 42> points{}; // x0, y0, x1, y1, ...
+};
+
+struct RecordedFace
+{
+    std::uint8_t has_face{0};
+    std::array<std::uint8_t, 3> reserved{};
+    float confidence{0.0f};
+    std::array<std::int32_t, 4> bbox{}; // x, y, w, h
+    std::array<float, 6> mouth{};       // center, left, right
+};
+
+struct LandmarkRecord
+{
+    double t_ms{0.0}; // stabilizer clock, relative to the start of the stream
+    std::uint32_t frame{0};
+    std::uint8_t hand_count{0};
+    std::uint8_t valid_roi{0};
+    std::uint8_t hand_updated{0}; // hand inference ran this frame
+    std::uint8_t reserved{0};
+    std::array<RecordedHand, landmark_record_max_hands> hands{};
+    RecordedFace face{};
+};
+
+static_assert(sizeof(LandmarkRecordHeader) == 16);
+static_assert(sizeof(RecordedHand) == 180);
+static_assert(sizeof(RecordedFace) == 48);
+static_assert(sizeof(LandmarkRecord) == 784);
+static_assert(std::is_trivially_copyable_v<LandmarkRecord>);
+
+RecordedHand to_recorded_hand(const HandLandmarkResult &hand, int track_id, bool updated, bool predicted);
+HandLandmarkResult to_hand_result(const RecordedHand &hand);
+
+RecordedFace to_recorded_face(const FaceLandmarkResult &face);
+FaceLandmarkResult to_face_result(const RecordedFace &face);
+
+class LandmarkRecorder
+{
+private:
+    std::ofstream file_;
+    std::string path_;
+
+public:
+    cvtool::core::ExitCode open(const std::string &path, int max_hands, std::string &err);
+    cvtool::core::ExitCode write(const LandmarkRecord &record, std::string &err);
+    cvtool::core::ExitCode close(std::string &err);
+
+    bool is_open() const { return file_.is_open(); }
+};
+
+// Reads the whole file with a single read; records keep their on-disk layout.
+cvtool::core::ExitCode read_landmark_records(
+    const std::string &path,
+    LandmarkRecordHeader &out_header,
+    std::vector<LandmarkRecord> &out_records,
+    std::string &err);
+
+}
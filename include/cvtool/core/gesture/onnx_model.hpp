@@ -0,0 +1,22 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+
+#include <string>
+#include <vector>
+
+namespace cvtool::core::gesture
+{
+
+struct ModelLoadTimings
+{
+    double read_ms{0.0};    // model file -> memory
+    double session_ms{0.0}; // Ort::Session creation (graph optimization)
+    double warmup_ms{0.0};
+};
+
+// Reads the whole model file so sessions are created from memory: no platform
+// specific (wide) path conversion and the file read can be timed on its own.
+cvtool::core::ExitCode read_model_file(const std::string &model_path, std::vector<char> &out_bytes, std::string &err);
+
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+
+#include <string>
+
+namespace cvtool::core::gesture
+{
+
+// Parity self-check of the detector input paths. One HandLandmarkDetector and one
+// FaceLandmarkDetector get a sequence of growing, shrinking and mixed-aspect crops
+// through their public input_blob(), so the reused resize buffer and letterbox
+// canvas carry state from crop to crop. Each tensor is compared bit for bit with
+// the previous resize -> cvtColor -> cv::dnn::blobFromImage output, and the SIMD
+// packer with the scalar one. One report line per case; fails on any difference.
+cvtool::core::ExitCode verify_preprocessing(int cases, std::string &report, std::string &err);
+
+}
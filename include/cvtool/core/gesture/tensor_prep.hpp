@@ -0,0 +1,16 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+namespace cvtool::core::gesture
+{
+
+// Packs an 8-bit BGR image into planar RGB floats in one pass:
+// dst[c * rows * cols + y * cols + x] = (src(y, x)[2 - c] - mean) * scale.
+// Same arithmetic as cv::dnn::blobFromImage(src, scale, src.size(), mean, swapRB = true).
+void pack_bgr_to_rgb_planar(const cv::Mat &bgr, float *dst, float mean, float scale);
+
+// Plain per-pixel version of the above, the reference for verify_preprocessing.
+void pack_bgr_to_rgb_planar_scalar(const cv::Mat &bgr, float *dst, float mean, float scale);
+
+}
@@ -11,6 +11,12 @@ namespace cvtool::core::image_io
 
 cvtool::core::ExitCode read_image(const std::string &in_path, cv::Mat &out_image, std::string &err);
 
+// For callers that shrink the image to fit inside max_size anyway: JPEGs are decoded
+// at 1/2, 1/4 or 1/8 scale in the DCT domain (IMREAD_REDUCED_*) as long as the result
+// still covers the fitted size. Other formats, and an empty max_size, decode at full size.
+cvtool::core::ExitCode read_image(const std::string &in_path, cv::Mat &out_image, std::string &err,
+                                  const cv::Size &max_size);
+
 cvtool::core::ExitCode write_image(const std::string &out_path, const cv::Mat &out_image, std::string &err);
 
 }
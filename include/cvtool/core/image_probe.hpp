@@ -0,0 +1,30 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace cvtool::core
+{
+
+// What cv::imread(..., IMREAD_UNCHANGED) would return, read from the file header only.
+struct ImageHeader
+{
+    std::string format; // png | jpeg | tiff | bmp | webp
+    int width{0};
+    int height{0};
+    int channels{0};
+    int depth{0}; // CV_8U, CV_16U, ...
+};
+
+// Parses PNG, JPEG, TIFF, BMP and WebP headers without decoding pixels.
+// Returns false for other formats and for headers whose imread result cannot be
+// predicted safely (e.g. 12-bit JPEG, BigTIFF, 32-bit BMP).
+bool parse_image_header(const unsigned char *data, std::size_t size, ImageHeader &out);
+
+// Maps path and parses its header; only the pages the parser touches are read.
+// InvalidParamsOrUnsupported means "not recognised": fall back to a full decode.
+cvtool::core::ExitCode probe_image_header(const std::string &path, ImageHeader &out, std::string &err);
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cvtool::core
+{
+
+enum class JsonLayout
+{
+    Pretty,  // 4-space indent, same text as nlohmann's std::setw(4) output
+    Compact, // no whitespace
+    Ndjson   // compact; the caller writes one document per line
+};
+
+bool parse_json_layout(const std::string &name, JsonLayout &out);
+
+// Writes JSON straight to a stream, one token at a time, so reports with any
+// number of items never exist as a DOM. Small leaf values (a bbox, a params
+// object) may still be passed as nlohmann values.
+class JsonStreamWriter
+{
+private:
+    struct Scope
+    {
+        bool array{false};
+        bool empty{true};
+    };
+
+    std::ostream &out_;
+    bool pretty_{true};
+    std::vector<Scope> scopes_;
+    bool after_key_{false};
+
+    void newline_indent(std::size_t depth);
+    void before_value();
+
+public:
+    JsonStreamWriter(std::ostream &out, JsonLayout layout);
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+
+    void key(std::string_view name);
+    void value(const nlohmann::ordered_json &v);
+
+    template <class T>
+    void field(std::string_view name, const T &v)
+    {
+        key(name);
+        value(nlohmann::ordered_json(v));
+    }
+
+    // Ends a top-level document (a whole report, or one NDJSON record).
+    void end_document();
+};
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace cvtool::core
+{
+
+// Log-linear latency histogram in the spirit of HdrHistogram. Values are kept in
+// microseconds: 0-63 us exactly, above that each power of two is split into 32
+// linear sub-buckets (~3% relative error). Recording is O(1) and never allocates.
+class LatencyHistogram
+{
+private:
+    static constexpr int linear_count = 64;
+    static constexpr int sub_bucket_count = 32;
+    static constexpr int max_shift = 35; // ~12 days
+    static constexpr int bucket_count = linear_count + max_shift * sub_bucket_count;
+
+    std::array<std::uint64_t, bucket_count> counts_{};
+    std::uint64_t total_{0};
+    double min_ms_{0.0};
+    double max_ms_{0.0};
+    double sum_ms_{0.0};
+
+    static int index_of(std::uint64_t us);
+    static std::uint64_t upper_bound_of(int index);
+
+public:
+    void record(double ms);
+    void reset();
+
+    std::uint64_t count() const { return total_; }
+    double min_ms() const { return min_ms_; }
+    double max_ms() const { return max_ms_; }
+    double mean_ms() const { return total_ > 0 ? sum_ms_ / total_ : 0.0; }
+
+    // p in [0, 100]; 0 when nothing was recorded.
+    double percentile_ms(double p) const;
+};
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace cvtool::core
+{
+
+// Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+class MappedFile
+{
+private:
+    const unsigned char *data_{nullptr};
+    std::size_t size_{0};
+    void *mapping_{nullptr}; // Windows file-mapping handle
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // read_ahead: the whole file will be read (decoding); otherwise only a few
+    // pages are touched (header parsing) and the kernel should not read ahead.
+    cvtool::core::ExitCode open(const std::string &path, std::string &err, bool read_ahead = true);
+    void close();
+
+    bool is_open() const { return data_ != nullptr; }
+    const unsigned char *data() const { return data_; }
+    std::size_t size() const { return size_; }
+};
+
+// Asks the OS to start reading path into the page cache; returns immediately.
+// Best effort: a no-op where the platform has no read-ahead hint.
+void prefetch_file(const std::string &path);
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "cvtool/core/exit_codes.hpp"
+
+#include <opencv2/core/mat.hpp>
+
+#include <functional>
+#include <string>
+
+namespace cvtool::core
+{
+
+// Computes one strip: src holds the strip plus up to `halo` rows above and below it
+// (fewer at the image border) as a standalone Mat; dst must receive the same number of rows.
+using StripFn = std::function<void(const cv::Mat &src, cv::Mat &dst)>;
+
+// Runs fn over horizontal strips of src in parallel and assembles the strips'
+// own rows into dst (allocated as src.size() x dst_type). Working memory is
+// bounded by the strip size instead of the image size. When halo covers the
+// vertical radius of everything fn does, the result is bit-exact to running fn
+// on the whole image: rows touched by a strip's artificial border are discarded.
+cvtool::core::ExitCode process_in_strips(
+    const cv::Mat &src,
+    cv::Mat &dst,
+    int dst_type,
+    int strip_rows,
+    int halo,
+    const StripFn &fn,
+    std::string &err);
+
+}
@@ -2,13 +2,57 @@
 
 #include "cvtool/core/exit_codes.hpp"
 
+#include <array>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <opencv2/core/mat.hpp>
 
+namespace cvtool::core::threshold
+{
+
+using Histogram = std::array<std::uint64_t, 256>;
+
+// Thresholds splitting the histogram into `classes` gray ranges with maximal
+// between-class variance (classes == 2 is plain Otsu). Threshold i is the last
+// value of class i; a pixel belongs to the classes above it when value > t.
+std::vector<int> otsu_thresholds(const std::array<double, 256> &hist, int classes);
+
+// Histogram carried across the frames of one sequence. Each new histogram is
+// normalized and blended in with weight alpha, so the thresholds follow
+// lighting changes without jumping on a single noisy frame.
+class OtsuState
+{
+private:
+    std::array<double, 256> hist_{};
+    double alpha_{0.2};
+    bool primed_{false};
+
+public:
+    explicit OtsuState(double alpha) : alpha_(alpha) {}
+
+    void update(const Histogram &hist);
+    std::vector<int> thresholds(int classes) const { return otsu_thresholds(hist_, classes); }
+};
+
+struct OtsuParams
+{
+    int classes{2};              // > 2: the mask keeps the brightest of `classes` gray classes
+    int sample{1};               // histogram from every sample-th row and column
+    OtsuState *state{nullptr};   // optional: smooth the histogram across calls
+};
+
+}
+
+// mode: otsu | adaptive | adaptive-mean-fast | bradley | sauvola | manual.
+// adaptive-mean-fast (mean - c), bradley (mean * (1 - p / 100)) and sauvola (k)
+// use integral images over a block x block window, so their cost does not grow
+// with the block size.
 cvtool::core::ExitCode make_binary_mask(
     const cv::Mat &src, 
     const std::string &mode, 
-    int blur_k, bool invert, int block, double c, int t, 
+    int blur_k, bool invert, int block, double c, double k, double p, int t, 
+    const cvtool::core::threshold::OtsuParams &otsu,
     cv::Mat &out_bin, std::string &err
-);
\ No newline at end of file
+);
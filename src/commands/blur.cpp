@@ -1,6 +1,7 @@
 #include "cvtool/commands/blur.hpp"
 #include "cvtool/core/validate.hpp"
 #include "cvtool/core/image_io.hpp"
+#include "cvtool/core/strip_processing.hpp"
 
 #include <opencv2/imgproc.hpp>
 
@@ -31,27 +32,45 @@ cvtool::core::ExitCode run_blur(const cvtool::cmd::BlurOptions &opt)
         return fail(blur_code);
     }
 
+    cv::Mat out = img;
     if (opt.blur_k >= 3)
     {
-        try
+        const cv::Size ksize(opt.blur_k, opt.blur_k);
+        if (opt.strip_rows > 0)
         {
-            cv::Mat out = img.clone();
-            cv::GaussianBlur(img, out, cv::Size(opt.blur_k, opt.blur_k), 0, 0);
+            const auto strips_code = cvtool::core::process_in_strips(
+                img, out, img.type(), opt.strip_rows, opt.blur_k / 2,
+                [&](const cv::Mat &src, cv::Mat &dst) { cv::GaussianBlur(src, dst, ksize, 0, 0); },
+                err);
+            if (strips_code != cvtool::core::ExitCode::Ok)
+            {
+                return fail(strips_code);
+            }
         }
-        catch (const cv::Exception &e)
+        else
         {
-            fmt::println(stderr, "error: blur failed ({})", e.what());
-            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+            try
+            {
+                cv::GaussianBlur(img, out, ksize, 0, 0);
+            }
+            catch (const cv::Exception &e)
+            {
+                fmt::println(stderr, "error: blur failed ({})", e.what());
+                return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+            }
         }
     }
 
     err.clear();
-    const auto write_code = cvtool::core::image_io::write_image(opt.out_path, img, err);
+    const auto write_code = cvtool::core::image_io::write_image(opt.out_path, out, err);
     if (write_code != cvtool::core::ExitCode::Ok)
     {
         return fail(write_code);
     }
 
+    if (opt.quiet)
+        return cvtool::core::ExitCode::Ok;
+
     fmt::println(
         "command: blur\n"
         "in: {}\n"
@@ -4,14 +4,148 @@
 #include "cvtool/core/validate.hpp"
 #include "cvtool/core/threshold.hpp"
 #include "cvtool/core/contours_core.hpp"
+#include "cvtool/core/json_stream.hpp"
+#include "cvtool/core/columnar.hpp"
 
 #include <nlohmann/json.hpp>
 
-#include <fmt/core.h>
+#include <fmt/format.h>
 
 #include <fstream>
-#include <iomanip>
-#include <algorithm>
+#include <string>
+#include <vector>
+
+static nlohmann::ordered_json item_json(const cvtool::core::contours::ContourItem &i)
+{
+    return {
+        {"id", i.id},
+        {"area", i.area},
+        {"bbox", {{"x", i.bbox.x}, {"y", i.bbox.y}, {"w", i.bbox.width}, {"h", i.bbox.height}}}};
+}
+
+// One "contours" table, one row per kept item; polygons stay JSON-only.
+static cvtool::core::ExitCode write_contours_columnar(
+    const std::string &path,
+    const std::vector<cvtool::core::contours::ContourItem> &items,
+    std::string &err)
+{
+    cvtool::core::columnar::Table t;
+    t.name = "contours";
+    t.rows = items.size();
+    t.add_column<std::int32_t>("id", [&](std::size_t r) { return items[r].id; });
+    t.add_column<double>("area", [&](std::size_t r) { return items[r].area; });
+    t.add_column<std::int32_t>("x", [&](std::size_t r) { return items[r].bbox.x; });
+    t.add_column<std::int32_t>("y", [&](std::size_t r) { return items[r].bbox.y; });
+    t.add_column<std::int32_t>("w", [&](std::size_t r) { return items[r].bbox.width; });
+    t.add_column<std::int32_t>("h", [&](std::size_t r) { return items[r].bbox.height; });
+
+    return cvtool::core::columnar::write_columnar(path, {t}, err);
+}
+
+// Streams the report; items go straight from the vector to the file, so any
+// number of contours can be written without building a DOM.
+static cvtool::core::ExitCode write_contours_json(
+    const cvtool::cmd::ContoursOptions &opt,
+    const std::vector<cvtool::core::contours::ContourItem> &items,
+    const cvtool::core::contours::ContourStats &stats,
+    std::string &err)
+{
+    cvtool::core::JsonLayout layout{};
+    if (!cvtool::core::parse_json_layout(opt.json_format, layout))
+    {
+        err = fmt::format("error: unknown json format: {}", opt.json_format);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    std::ofstream file(opt.json_path);
+    if (!file)
+    {
+        err = fmt::format("error: cannot open json output '{}'", opt.json_path);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    nlohmann::ordered_json params = nlohmann::ordered_json::object();
+    if (opt.thresh == "adaptive" || opt.thresh == "adaptive-mean-fast")
+    {
+        params = {
+            {"block", opt.block},
+            {"c", opt.c}
+        };
+    } else if (opt.thresh == "bradley")
+    {
+        params = {
+            {"block", opt.block},
+            {"p", opt.p}
+        };
+    } else if (opt.thresh == "sauvola")
+    {
+        params = {
+            {"block", opt.block},
+            {"k", opt.k}
+        };
+    } else if (opt.thresh == "manual")
+    {
+        params = {
+            {"t", opt.t}
+        };
+    } else if (opt.thresh == "otsu")
+    {
+        params = {
+            {"classes", opt.otsu_classes},
+            {"sample", opt.otsu_sample},
+            {"smoothing", opt.otsu_smoothing}
+        };
+    }
+
+    cvtool::core::JsonStreamWriter w(file, layout);
+    w.begin_object();
+    w.field("command", "contours");
+    w.field("input", opt.in_path);
+    w.field("output", opt.out_path);
+    w.key("threshold");
+    w.value({{"mode", opt.thresh}, {"blur_k", opt.blur_k}, {"invert", opt.invert}, {"params", params}});
+    w.field("area", opt.stats_only ? "pixels" : "polygon");
+    w.key("stats");
+    w.value({
+        {"contours_total", stats.contours_total},
+        {"contours_kept", stats.contours_kept},
+        {"area_min", stats.area_min},
+        {"area_mean", stats.area_mean},
+        {"area_max", stats.area_max}
+    });
+    w.field("items_truncated", false);
+
+    // NDJSON: the header above is the first line, then one line per item.
+    if (layout == cvtool::core::JsonLayout::Ndjson)
+    {
+        w.end_object();
+        w.end_document();
+        for (const auto &i : items)
+        {
+            w.value(item_json(i));
+            w.end_document();
+        }
+    }
+    else
+    {
+        w.key("items");
+        w.begin_array();
+        for (const auto &i : items)
+            w.value(item_json(i));
+        w.end_array();
+        w.end_object();
+        w.end_document();
+    }
+
+    file.flush();
+    if (!file.good())
+    {
+        err = fmt::format("error: failed to write json output: {}", opt.json_path);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
 
 cvtool::core::ExitCode run_contours(const cvtool::cmd::ContoursOptions &opt)
 {
@@ -39,7 +173,8 @@ cvtool::core::ExitCode run_contours(const cvtool::cmd::ContoursOptions &opt)
         return thresh_code;
     }
 
-    if (opt.thresh == "adaptive")
+    if (opt.thresh == "adaptive" || opt.thresh == "adaptive-mean-fast" || opt.thresh == "bradley" ||
+        opt.thresh == "sauvola")
     {
         const auto adaptive_code = cvtool::core::validate::validate_adaptive_block(opt.block, err);
         if (adaptive_code != cvtool::core::ExitCode::Ok)
@@ -65,16 +200,23 @@ cvtool::core::ExitCode run_contours(const cvtool::cmd::ContoursOptions &opt)
         return draw_code;
     }
 
-    fmt::println(
-        "command: contours\n"
-        "in: {}\n"
-        "out: {}\n"
-        "thresh: {}\n"
-        "params: blur_k={} min_area={} invert={} draw={}",
-        opt.in_path,
-        opt.out_path,
-        opt.thresh,
-        opt.blur_k, opt.min_area, opt.invert, opt.draw);
+    if (opt.stats_only && opt.draw != "bbox")
+    {
+        fmt::println(stderr, "error: --stats-only builds no contour polygons to draw (use --draw bbox)");
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    if (!opt.quiet)
+        fmt::println(
+            "command: contours\n"
+            "in: {}\n"
+            "out: {}\n"
+            "thresh: {}\n"
+            "params: blur_k={} min_area={} invert={} draw={}",
+            opt.in_path,
+            opt.out_path,
+            opt.thresh,
+            opt.blur_k, opt.min_area, opt.invert, opt.draw);
 
     const cvtool::core::ExitCode read_code = cvtool::core::image_io::read_image(opt.in_path, img, err);
     if (read_code != cvtool::core::ExitCode::Ok)
@@ -91,7 +233,10 @@ cvtool::core::ExitCode run_contours(const cvtool::cmd::ContoursOptions &opt)
         opt.invert,
         opt.block,
         opt.c,
+        opt.k,
+        opt.p,
         opt.t,
+        {opt.otsu_classes, opt.otsu_sample, opt.otsu_state.get()},
         bin,
         err);
     if (mask_code != cvtool::core::ExitCode::Ok)
@@ -102,7 +247,9 @@ cvtool::core::ExitCode run_contours(const cvtool::cmd::ContoursOptions &opt)
 
     std::vector<cvtool::core::contours::ContourItem> items;
     cvtool::core::contours::ContourStats stats;
-    const cvtool::core::ExitCode cont_code = cvtool::core::contours::find_contours_report(bin, opt.min_area, items, stats, err);
+    const cvtool::core::ExitCode cont_code = opt.stats_only
+        ? cvtool::core::contours::find_components_report(bin, opt.min_area, items, stats, err)
+        : cvtool::core::contours::find_contours_report(bin, opt.min_area, items, stats, err);
     if (cont_code != cvtool::core::ExitCode::Ok)
     {
         fmt::println(stderr, "{}", err);
@@ -147,72 +294,21 @@ cvtool::core::ExitCode run_contours(const cvtool::cmd::ContoursOptions &opt)
 
     if(!opt.json_path.empty())
     {
-        static constexpr size_t kMaxItems = 200;
-        bool truncated = items.size() > kMaxItems;
-        std::size_t n = std::min(items.size(), kMaxItems);
-
-        nlohmann::ordered_json items_array = nlohmann::ordered_json::array();
-        for (std::size_t idx = 0; idx < n; idx++)
+        const cvtool::core::ExitCode json_code = write_contours_json(opt, items, stats, err);
+        if (json_code != cvtool::core::ExitCode::Ok)
         {
-            const auto &i = items[idx];
-            nlohmann::ordered_json single_item;
-            single_item["id"] = i.id;
-            single_item["area"] = i.area;
-            single_item["bbox"] = {
-                {"x", i.bbox.x},
-                {"y", i.bbox.y},
-                {"w", i.bbox.width},
-                {"h", i.bbox.height}
-            };
-            items_array.push_back(single_item);
-        }
-
-        nlohmann::ordered_json j;
-        j["command"] = "contours";
-        j["input"] = opt.in_path;
-        j["output"] = opt.out_path;
-        j["threshold"]["mode"] = opt.thresh;
-        j["threshold"]["blur_k"] = opt.blur_k;
-        j["threshold"]["invert"] = opt.invert;
-        if (opt.thresh == "adaptive")
-        {
-            j["threshold"]["params"] = {
-                {"block", opt.block},
-                {"c", opt.c}
-            };
-        } else if (opt.thresh == "manual")
-        {
-            j["threshold"]["params"] = {
-                {"t", opt.t}
-            };
-        } else
-        {
-            j["threshold"]["params"] = nlohmann::ordered_json::object();
-        }
-        
-        j["stats"] = {
-            {"contours_total", stats.contours_total},
-            {"contours_kept", stats.contours_kept},
-            {"area_min", stats.area_min},
-            {"area_mean", stats.area_mean},
-            {"area_max", stats.area_max}
-        };
-        j["items_truncated"] = truncated;
-        j["items"] = items_array;
-        
-
-        std::ofstream file(opt.json_path);
-        if (!file)
-        {
-            fmt::println(stderr, "error: cannot open json output '{}'", opt.json_path);
-            return cvtool::core::ExitCode::CannotWriteOutput;
+            fmt::println(stderr, "{}", err);
+            return json_code;
         }
+    }
 
-        file << std::setw(4) << j << "\n";
-        if (!file.good())
+    if (!opt.bin_path.empty())
+    {
+        const cvtool::core::ExitCode bin_code = write_contours_columnar(opt.bin_path, items, err);
+        if (bin_code != cvtool::core::ExitCode::Ok)
         {
-            fmt::println(stderr, "error: failed to write json output: {}", opt.json_path);
-            return cvtool::core::ExitCode::CannotWriteOutput;
+            fmt::println(stderr, "{}", err);
+            return bin_code;
         }
     }
 
@@ -223,6 +319,9 @@ cvtool::core::ExitCode run_contours(const cvtool::cmd::ContoursOptions &opt)
         return write_code;
     }
 
+    if (opt.quiet)
+        return cvtool::core::ExitCode::Ok;
+
     fmt::println(
         "status: ok\n"
         "contours_total: {}\n"
@@ -19,14 +19,22 @@ cvtool::core::ExitCode run_edges(const cvtool::cmd::EdgesOptions &opt)
     }
 
     cv::Mat edges_image;
-    const auto pipeline_status = cvtool::core::edges_frame_to_gray(
-        source_image,
-        opt.threshold_low,
-        opt.threshold_high,
-        opt.blur_k,
-        edges_image,
-        err
-    );
+    const auto pipeline_status = opt.strip_rows > 0
+        ? cvtool::core::edges_frame_to_gray_in_strips(
+              source_image,
+              opt.threshold_low,
+              opt.threshold_high,
+              opt.blur_k,
+              opt.strip_rows,
+              edges_image,
+              err)
+        : cvtool::core::edges_frame_to_gray(
+              source_image,
+              opt.threshold_low,
+              opt.threshold_high,
+              opt.blur_k,
+              edges_image,
+              err);
     if (pipeline_status != cvtool::core::ExitCode::Ok)
     {
         fmt::println(stderr, "{}", err);
@@ -40,6 +48,9 @@ cvtool::core::ExitCode run_edges(const cvtool::cmd::EdgesOptions &opt)
         return write_status;
     }
 
+    if (opt.quiet)
+        return cvtool::core::ExitCode::Ok;
+
     fmt::println(
         "command: edges\n"
         "in: {}\n"
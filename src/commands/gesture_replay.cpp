@@ -0,0 +1,264 @@
+#include "cvtool/commands/gesture_replay.hpp"
+#include "cvtool/core/gesture/landmark_record.hpp"
+#include "cvtool/core/gesture/gesture_batch.hpp"
+#include "cvtool/core/gesture/gesture_classifier.hpp"
+#include "cvtool/core/gesture/gesture_rules.hpp"
+#include "cvtool/core/gesture/gesture_rule_table.hpp"
+#include "cvtool/core/gesture/contextual_gesture_rules.hpp"
+#include "cvtool/core/gesture/gesture_stabilizer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct ReplayTrack
+{
+    cvtool::core::gesture::GestureStabilizer stabilizer;
+    cvtool::core::gesture::ClassifierResult raw_gesture{cvtool::core::gesture::GestureID::None};
+    cvtool::core::gesture::StabilizerResult stab_res{};
+    bool seen{false};
+
+    ReplayTrack(int stable_frames, int cooldown_ms)
+        : stabilizer(stable_frames, cooldown_ms)
+    {
+    }
+};
+
+}
+
+static cvtool::core::gesture::ClassifierResult classify_recorded_hand(
+    const cvtool::core::gesture::HandLandmarkResult &hand,
+    const cvtool::core::gesture::FaceLandmarkResult &face,
+    bool contextual,
+    const cvtool::core::gesture::GestureRuleTable *rules)
+{
+    if (!cvtool::core::gesture::can_classify_hand(hand))
+        return {cvtool::core::gesture::GestureID::None, {}};
+
+    return cvtool::core::gesture::classify_gesture(hand, face, contextual, rules);
+}
+
+// Same result as classify_recorded_hand for every frame of a single-hand
+// recording, computed with the SIMD batch classifiers.
+static std::vector<cvtool::core::gesture::GestureID> classify_single_hand_batch(
+    const std::vector<cvtool::core::gesture::LandmarkRecord> &records, bool contextual)
+{
+    const std::size_t n = records.size();
+
+    cvtool::core::gesture::HandLandmarkBatch hands;
+    cvtool::core::gesture::FaceLandmarkBatch faces;
+    hands.reserve(n);
+    faces.reserve(n);
+    for (const auto &record : records)
+    {
+        hands.push_back(cvtool::core::gesture::to_hand_result(record.hands[0]));
+        faces.push_back(cvtool::core::gesture::to_face_result(record.face));
+    }
+
+    std::vector<std::uint8_t> ok(n);
+    std::vector<std::uint8_t> masks(n);
+    std::vector<cvtool::core::gesture::GestureID> gestures(n);
+    cvtool::core::gesture::can_classify_hand_batch(hands, ok.data());
+    cvtool::core::gesture::classify_hand_gesture_batch(hands, gestures.data(), masks.data());
+
+    std::vector<cvtool::core::gesture::GestureID> contextual_gestures;
+    if (contextual)
+    {
+        contextual_gestures.resize(n);
+        cvtool::core::gesture::classify_contextual_gesture_batch(hands, faces, contextual_gestures.data(), masks.data());
+    }
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (ok[i] == 0)
+        {
+            gestures[i] = cvtool::core::gesture::GestureID::None;
+            continue;
+        }
+
+        if (contextual &&
+            contextual_gestures[i] != cvtool::core::gesture::GestureID::None &&
+            contextual_gestures[i] != cvtool::core::gesture::GestureID::Unknown &&
+            (gestures[i] == cvtool::core::gesture::GestureID::Unknown ||
+             gestures[i] == cvtool::core::gesture::GestureID::Fist))
+        {
+            gestures[i] = contextual_gestures[i];
+        }
+    }
+
+    return gestures;
+}
+
+cvtool::core::ExitCode run_gesture_replay(const cvtool::cmd::GestureReplayOptions &opt)
+{
+    std::string err;
+
+    cvtool::core::gesture::GestureRuleTable rule_table;
+    const cvtool::core::gesture::GestureRuleTable *rules{nullptr};
+    if (!opt.rules_path.empty())
+    {
+        auto rules_code = cvtool::core::gesture::load_gesture_rules(opt.rules_path, rule_table, err);
+        if (rules_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return rules_code;
+        }
+        rules = &rule_table;
+    }
+
+    cvtool::core::gesture::LandmarkRecordHeader header;
+    std::vector<cvtool::core::gesture::LandmarkRecord> records;
+    auto read_code = cvtool::core::gesture::read_landmark_records(opt.in_path, header, records, err);
+    if (read_code != cvtool::core::ExitCode::Ok)
+    {
+        fmt::println(stderr, "{}", err);
+        return read_code;
+    }
+    if (records.empty())
+    {
+        fmt::println(stderr, "error: landmark recording has no frames: {}", opt.in_path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    const bool multi_hand = header.max_hands > 1;
+    const bool contextual = opt.enable_contextual_gestures;
+
+    const auto replay_start = std::chrono::steady_clock::now();
+
+    std::vector<cvtool::core::gesture::GestureID> batch_gestures;
+    if (!multi_hand && rules == nullptr)
+        batch_gestures = classify_single_hand_batch(records, contextual);
+
+    cvtool::core::gesture::GestureStabilizer stabilizer{opt.stable_frames, opt.cooldown_ms};
+    std::map<int, ReplayTrack> tracks;
+    std::size_t stable_changes{0};
+
+    for (int pass = 0; pass < opt.repeat; pass++)
+    {
+        const bool print_frames = !opt.quiet && pass == 0;
+
+        // Like gesture-show, the stabilizer clock starts at "now" so the first cooldown has already expired.
+        const auto stream_start = std::chrono::steady_clock::now();
+        stabilizer.reset();
+        tracks.clear();
+
+        cvtool::core::gesture::ClassifierResult raw_gesture{cvtool::core::gesture::GestureID::None};
+        cvtool::core::gesture::StabilizerResult stab_res{};
+
+        for (std::size_t i = 0; i < records.size(); i++)
+        {
+            const auto &record = records[i];
+            const auto time_now = stream_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                     std::chrono::duration<double, std::milli>(record.t_ms));
+            const auto previous_stable = stab_res.stable_gesture;
+            const int hand_count = std::min<int>(record.hand_count, cvtool::core::gesture::landmark_record_max_hands);
+
+            if (multi_hand && record.valid_roi)
+            {
+                const auto face = cvtool::core::gesture::to_face_result(record.face);
+
+                for (auto &entry : tracks)
+                    entry.second.seen = false;
+
+                for (int h = 0; h < hand_count; h++)
+                {
+                    const auto &recorded = record.hands[h];
+                    auto &track = tracks.try_emplace(recorded.track_id, opt.stable_frames, opt.cooldown_ms).first->second;
+                    track.seen = true;
+
+                    if (recorded.updated || recorded.predicted)
+                    {
+                        track.raw_gesture = classify_recorded_hand(
+                            cvtool::core::gesture::to_hand_result(recorded), face, contextual, rules);
+                        track.stab_res = track.stabilizer.update(track.raw_gesture.gesture, time_now);
+                    }
+                }
+
+                std::erase_if(tracks, [](const auto &entry) { return !entry.second.seen; });
+
+                if (hand_count > 0)
+                {
+                    const auto &front = tracks.at(record.hands[0].track_id);
+                    raw_gesture = front.raw_gesture;
+                    stab_res = front.stab_res;
+                }
+                else if (record.hand_updated)
+                {
+                    raw_gesture = {cvtool::core::gesture::GestureID::None, {}};
+                    stab_res = stabilizer.update(cvtool::core::gesture::GestureID::None, time_now);
+                }
+            }
+            else if (hand_count > 0 && (record.hands[0].updated || record.hands[0].predicted))
+            {
+                if (!batch_gestures.empty())
+                    raw_gesture = {batch_gestures[i], {}};
+                else
+                    raw_gesture = classify_recorded_hand(
+                        cvtool::core::gesture::to_hand_result(record.hands[0]),
+                        cvtool::core::gesture::to_face_result(record.face), contextual, rules);
+
+                stab_res = stabilizer.update(raw_gesture.gesture, time_now);
+            }
+            else if (!record.valid_roi)
+            {
+                tracks.clear();
+                raw_gesture = {cvtool::core::gesture::GestureID::None, {}};
+                stab_res = stabilizer.update(cvtool::core::gesture::GestureID::None, time_now);
+            }
+
+            if (pass == 0 && stab_res.stable_gesture != previous_stable)
+                stable_changes++;
+
+            if (!print_frames)
+                continue;
+
+            nlohmann::json j;
+            j["frame"] = record.frame;
+            j["t_ms"] = record.t_ms;
+            j["raw_gesture"] = std::string(cvtool::core::gesture::to_asset_key(raw_gesture.gesture));
+            j["stable_gesture"] = std::string(cvtool::core::gesture::to_asset_key(stab_res.stable_gesture));
+            if (multi_hand)
+            {
+                j["hands"] = nlohmann::json::array();
+                for (int h = 0; h < hand_count; h++)
+                {
+                    const auto it = tracks.find(record.hands[h].track_id);
+                    if (it == tracks.end())
+                        continue;
+                    j["hands"].push_back({
+                        {"id", it->first},
+                        {"raw_gesture", std::string(cvtool::core::gesture::to_asset_key(it->second.raw_gesture.gesture))},
+                        {"stable_gesture", std::string(cvtool::core::gesture::to_asset_key(it->second.stab_res.stable_gesture))}});
+                }
+            }
+            fmt::println("{}", j.dump());
+        }
+    }
+
+    const double total_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - replay_start).count();
+    const double frames = static_cast<double>(records.size()) * opt.repeat;
+
+    fmt::println(stderr,
+                 "frames: {}\n"
+                 "repeat: {}\n"
+                 "stable_changes: {}\n"
+                 "time_ms: {:.1f}\n"
+                 "frames_per_s: {:.0f}",
+                 records.size(),
+                 opt.repeat,
+                 stable_changes,
+                 total_ms,
+                 total_ms > 0.0 ? frames * 1000.0 / total_ms : 0.0);
+
+    return cvtool::core::ExitCode::Ok;
+}
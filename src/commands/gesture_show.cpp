@@ -1,23 +1,229 @@
 #include "cvtool/commands/gesture_show.hpp"
 #include "cvtool/core/validate.hpp"
+#include "cvtool/core/video_io.hpp"
+#include "cvtool/core/frame_capture.hpp"
+#include "cvtool/core/latency_histogram.hpp"
 #include "cvtool/core/gesture/gesture_bank.hpp"
 #include "cvtool/core/gesture/display_utils.hpp"
 #include "cvtool/core/gesture/gesture_domain.hpp"
 #include "cvtool/core/gesture/hand_landmark_detector.hpp"
 #include "cvtool/core/gesture/gesture_rules.hpp"
+#include "cvtool/core/gesture/gesture_rule_table.hpp"
 #include "cvtool/core/gesture/gesture_stabilizer.hpp"
+#include "cvtool/core/gesture/landmark_filter.hpp"
+#include "cvtool/core/gesture/hand_tracker.hpp"
 #include "cvtool/core/gesture/face_landmark_detector.hpp"
 #include "cvtool/core/gesture/contextual_gesture_rules.hpp"
+#include "cvtool/core/gesture/gesture_classifier.hpp"
+#include "cvtool/core/gesture/landmark_record.hpp"
 
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 
+#include <nlohmann/json.hpp>
+
 #include <fmt/core.h>
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <vector>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+
+struct FrameTimings
+{
+    double queue_ms{0.0}; // capture -> dequeued by the loop
+    double hand_ms{0.0};
+    double face_ms{0.0};
+    double classify_ms{0.0};
+    double stabilize_ms{0.0};
+    double display_ms{0.0};
+    double frame_ms{0.0};
+    double latency_ms{0.0}; // capture -> output
+};
+
+enum LoopStage
+{
+    StageCapture,
+    StageHand,
+    StageFace,
+    StageClassify,
+    StageStabilize,
+    StageDisplay,
+    StageEndToEnd,
+    StageCount
+};
+
+constexpr std::array<const char *, StageCount> stage_names{
+    "capture", "hand", "face", "classify", "stabilize", "display", "end_to_end"};
+
+using StageHistograms = std::array<cvtool::core::LatencyHistogram, StageCount>;
+
+// Stages that did not run on this frame (skipped inference, headless display) are not recorded.
+static void record_frame_timings(
+    StageHistograms &histograms, const FrameTimings &timings,
+    bool hand_ran, bool face_ran, bool displayed)
+{
+    histograms[StageCapture].record(timings.queue_ms);
+    if (hand_ran)
+        histograms[StageHand].record(timings.hand_ms);
+    if (face_ran)
+        histograms[StageFace].record(timings.face_ms);
+    histograms[StageClassify].record(timings.classify_ms);
+    histograms[StageStabilize].record(timings.stabilize_ms);
+    if (displayed)
+        histograms[StageDisplay].record(timings.display_ms);
+    histograms[StageEndToEnd].record(timings.latency_ms);
+}
+
+static void print_latency_summary(const StageHistograms &histograms)
+{
+    fmt::println(stderr, "{:<11} {:>7} {:>9} {:>9} {:>9} {:>9}  (ms)", "stage", "count", "p50", "p95", "p99", "max");
+    for (int s = 0; s < StageCount; s++)
+    {
+        const auto &h = histograms[s];
+        fmt::println(stderr, "{:<11} {:>7} {:>9.2f} {:>9.2f} {:>9.2f} {:>9.2f}",
+                     stage_names[s], h.count(),
+                     h.percentile_ms(50.0), h.percentile_ms(95.0), h.percentile_ms(99.0), h.max_ms());
+    }
+}
+
+static cvtool::core::ExitCode write_latency_report(
+    const std::string &path, const StageHistograms &histograms, std::string &err)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        err = fmt::format("error: cannot open latency output '{}'", path);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    if (std::filesystem::path(path).extension() == ".csv")
+    {
+        file << "stage,count,min_ms,mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+        for (int s = 0; s < StageCount; s++)
+        {
+            const auto &h = histograms[s];
+            file << fmt::format("{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f}\n",
+                                stage_names[s], h.count(), h.min_ms(), h.mean_ms(),
+                                h.percentile_ms(50.0), h.percentile_ms(95.0), h.percentile_ms(99.0), h.max_ms());
+        }
+    }
+    else
+    {
+        nlohmann::json j;
+        j["stages"] = nlohmann::json::array();
+        for (int s = 0; s < StageCount; s++)
+        {
+            const auto &h = histograms[s];
+            j["stages"].push_back({{"stage", stage_names[s]},
+                                   {"count", h.count()},
+                                   {"min_ms", h.min_ms()},
+                                   {"mean_ms", h.mean_ms()},
+                                   {"p50_ms", h.percentile_ms(50.0)},
+                                   {"p95_ms", h.percentile_ms(95.0)},
+                                   {"p99_ms", h.percentile_ms(99.0)},
+                                   {"max_ms", h.max_ms()}});
+        }
+        file << std::setw(4) << j << '\n';
+    }
+
+    if (!file.good())
+    {
+        err = fmt::format("error: failed to write latency output: {}", path);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+static double elapsed_ms(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+static nlohmann::ordered_json frame_to_json(
+    int frame_index, double t_ms,
+    const cvtool::core::gesture::HandLandmarkResult &hand,
+    const cvtool::core::gesture::FaceLandmarkResult &face,
+    cvtool::core::gesture::GestureID raw_id,
+    const cvtool::core::gesture::StabilizerResult &stab_res,
+    bool hand_updated,
+    bool hand_predicted,
+    const std::vector<cvtool::core::gesture::HandTrack> *tracks,
+    const FrameTimings &timings)
+{
+    nlohmann::ordered_json j;
+    j["frame"] = frame_index;
+    j["t_ms"] = t_ms;
+
+    j["hand"]["has_hand"] = hand.has_hand;
+    j["hand"]["updated"] = hand_updated;
+    j["hand"]["predicted"] = hand_predicted;
+    j["hand"]["confidence"] = hand.confidence;
+    j["hand"]["handedness"] = hand.hand == cvtool::core::gesture::Handedness::Left    ? "left"
+                              : hand.hand == cvtool::core::gesture::Handedness::Right ? "right"
+                                                                                      : "none";
+    nlohmann::ordered_json points = nlohmann::ordered_json::array();
+    if (hand.has_hand)
+    {
+        for (const auto &p : hand.points)
+            points.push_back({p.x, p.y});
+    }
+    j["hand"]["points"] = points;
+
+    if (tracks != nullptr)
+    {
+        j["hands"] = nlohmann::ordered_json::array();
+        for (const auto &track : *tracks)
+        {
+            nlohmann::ordered_json track_points = nlohmann::ordered_json::array();
+            if (track.hand.has_hand)
+            {
+                for (const auto &p : track.hand.points)
+                    track_points.push_back({p.x, p.y});
+            }
+
+            j["hands"].push_back({
+                {"id", track.id},
+                {"has_hand", track.hand.has_hand},
+                {"updated", track.updated},
+                {"predicted", track.predicted},
+                {"confidence", track.hand.confidence},
+                {"raw_gesture", std::string(cvtool::core::gesture::to_asset_key(track.raw_gesture.gesture))},
+                {"stable_gesture", std::string(cvtool::core::gesture::to_asset_key(track.stab_res.stable_gesture))},
+                {"points", track_points}});
+        }
+    }
+
+    j["face"]["has_face"] = face.has_face;
+    j["face"]["confidence"] = face.confidence;
+    if (face.has_face)
+    {
+        j["face"]["bbox"] = {
+            {"x", face.bbox.x}, {"y", face.bbox.y}, {"w", face.bbox.width}, {"h", face.bbox.height}};
+        j["face"]["mouth"] = {face.mouth_center.x, face.mouth_center.y};
+    }
+
+    j["raw_gesture"] = std::string(cvtool::core::gesture::to_asset_key(raw_id));
+    j["stable_gesture"] = std::string(cvtool::core::gesture::to_asset_key(stab_res.stable_gesture));
+    j["candidate_gesture"] = std::string(cvtool::core::gesture::to_asset_key(stab_res.candidate_gesture));
+    j["candidate_count"] = stab_res.candidate_count;
+
+    j["timings_ms"] = {
+        {"hand", timings.hand_ms},
+        {"face", timings.face_ms},
+        {"classify", timings.classify_ms},
+        {"stabilize", timings.stabilize_ms},
+        {"frame", timings.frame_ms},
+        {"latency", timings.latency_ms}};
+
+    return j;
+}
 
 static void render_debug_overlay(
     const cvtool::cmd::GestureShowOptions &opt,
@@ -25,7 +231,10 @@ static void render_debug_overlay(
     cv::Rect sr, cvtool::core::gesture::GestureID raw_id,
     cvtool::core::gesture::StabilizerResult &stab_res,
     float confidence, std::string fingers_str,
-    const cvtool::core::gesture::FaceLandmarkResult &face_result)
+    const cvtool::core::gesture::FaceLandmarkResult &face_result,
+    const cvtool::core::CaptureStats &capture_stats,
+    double capture_latency_ms,
+    const StageHistograms &histograms)
 {
     int x{10};
     int y{30};
@@ -96,6 +305,30 @@ static void render_debug_overlay(
                 cv::Point(x, y + line_height * 9),
                 cv::FONT_HERSHEY_SIMPLEX, 0.5, color, 1,
                 cv::LINE_AA);
+
+    cv::putText(frame,
+                fmt::format("capture: {:.1f} fps, dropped: {}, latency: {:.1f} ms",
+                            capture_stats.fps, capture_stats.dropped, capture_latency_ms),
+                cv::Point(x, y + line_height * 10),
+                cv::FONT_HERSHEY_SIMPLEX, 0.5, color, 1,
+                cv::LINE_AA);
+
+    cv::putText(frame,
+                "latency p50 / p95 / p99 (ms):",
+                cv::Point(x, y + line_height * 11),
+                cv::FONT_HERSHEY_SIMPLEX, 0.5, color, 1,
+                cv::LINE_AA);
+
+    for (int s = 0; s < StageCount; s++)
+    {
+        const auto &h = histograms[s];
+        cv::putText(frame,
+                    fmt::format("  {}: {:.1f} / {:.1f} / {:.1f}",
+                                stage_names[s], h.percentile_ms(50.0), h.percentile_ms(95.0), h.percentile_ms(99.0)),
+                    cv::Point(x, y + line_height * (12 + s)),
+                    cv::FONT_HERSHEY_SIMPLEX, 0.5, color, 1,
+                    cv::LINE_AA);
+    }
 }
 
 static void draw_hand_landmarks(
@@ -124,20 +357,146 @@ static void draw_hand_landmarks(
     }
 }
 
+static bool classify_and_stabilize(
+    const cvtool::core::gesture::HandLandmarkResult &hand,
+    const cvtool::core::gesture::FaceLandmarkResult &face,
+    bool contextual,
+    const cvtool::core::gesture::GestureRuleTable *rules,
+    cvtool::core::gesture::GestureStabilizer &stabilizer,
+    std::chrono::steady_clock::time_point time_now,
+    cvtool::core::gesture::ClassifierResult &raw_gesture,
+    cvtool::core::gesture::StabilizerResult &stab_res,
+    double &stabilize_ms)
+{
+    const auto stabilize = [&](cvtool::core::gesture::GestureID id)
+    {
+        const auto stabilize_start = std::chrono::steady_clock::now();
+        stab_res = stabilizer.update(id, time_now);
+        stabilize_ms += elapsed_ms(stabilize_start);
+    };
+
+    if (!cvtool::core::gesture::can_classify_hand(hand))
+    {
+        raw_gesture = {cvtool::core::gesture::GestureID::None, {}};
+        stabilize(cvtool::core::gesture::GestureID::None);
+        return false;
+    }
+
+    raw_gesture = cvtool::core::gesture::classify_gesture(hand, face, contextual, rules);
+    stabilize(raw_gesture.gesture);
+    return true;
+}
+
+static std::string fingers_to_string(const cvtool::core::gesture::FingerState &state)
+{
+    return fmt::format(
+        "T={} I={} M={} R={} P={}",
+        state.thumb_extended ? 1 : 0,
+        state.index_extended ? 1 : 0,
+        state.middle_extended ? 1 : 0,
+        state.ring_extended ? 1 : 0,
+        state.pinky_extended ? 1 : 0);
+}
+
+struct StartupTimings
+{
+    double camera_ms{0.0};
+    double bank_ms{0.0};
+    double model_wait_ms{0.0}; // main thread blocked on model loading after its own setup
+    double first_capture_ms{0.0};
+    double first_inference_ms{0.0};
+};
+
+static void print_startup_report(
+    double total_ms, const StartupTimings &startup,
+    const cvtool::core::gesture::HandLandmarkDetector &hand_detector,
+    const cvtool::core::gesture::FaceLandmarkDetector *face_detector)
+{
+    const auto model_line = [](const char *name, const cvtool::core::gesture::ModelLoadTimings &t)
+    {
+        fmt::println(stderr, "  {} model: read {:.1f} ms, session {:.1f} ms, warm-up {:.1f} ms",
+                     name, t.read_ms, t.session_ms, t.warmup_ms);
+    };
+
+    fmt::println(stderr, "startup: time to first frame {:.1f} ms", total_ms);
+    model_line("hand", hand_detector.load_timings());
+    if (face_detector != nullptr)
+        model_line("face", face_detector->load_timings());
+    fmt::println(stderr,
+                 "  camera open: {:.1f} ms\n"
+                 "  gesture images: {:.1f} ms\n"
+                 "  waiting for models: {:.1f} ms\n"
+                 "  first capture: {:.1f} ms\n"
+                 "  first inference: {:.1f} ms",
+                 startup.camera_ms, startup.bank_ms, startup.model_wait_ms,
+                 startup.first_capture_ms, startup.first_inference_ms);
+}
+
 cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &opt)
 {
+    const auto startup_start = std::chrono::steady_clock::now();
+    StartupTimings startup;
+
     std::string err;
     std::vector<std::string> warnings;
 
-    cv::VideoCapture cap(opt.cam);
-    if (!cap.isOpened())
+    // Sessions are created (and warmed up) on worker threads while the camera
+    // opens and the gesture images load.
+    cvtool::core::gesture::HandLandmarkDetector hand_detector;
+    cvtool::core::gesture::FaceLandmarkDetector face_detector;
+    const bool with_face_model = !opt.face_model_path.empty();
+    const std::size_t warmup_batch = opt.max_hands > 1 ? static_cast<std::size_t>(opt.max_hands) + 1 : 1;
+
+    std::string hand_err;
+    auto hand_task = std::async(std::launch::async, [&]
+    {
+        auto code = hand_detector.initialize(opt.hand_model_path, hand_err);
+        if (code == cvtool::core::ExitCode::Ok && opt.warmup_runs > 0)
+            code = hand_detector.warm_up(opt.warmup_runs, hand_err, warmup_batch);
+        return code;
+    });
+
+    std::string face_err;
+    std::future<cvtool::core::ExitCode> face_task;
+    if (with_face_model)
     {
-        fmt::println(stderr, "Cannot open the camera");
-        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+        face_task = std::async(std::launch::async, [&]
+        {
+            auto code = face_detector.initialize(opt.face_model_path, face_err, opt.face_input_size);
+            if (code == cvtool::core::ExitCode::Ok && opt.warmup_runs > 0)
+                code = face_detector.warm_up(opt.warmup_runs, face_err);
+            return code;
+        });
+    }
+
+    const bool from_file = !opt.in_path.empty();
+    double file_fps{30.0};
+
+    const auto camera_start = std::chrono::steady_clock::now();
+    cv::VideoCapture cap;
+    if (from_file)
+    {
+        VideoMeta meta;
+        const auto open_code = open_video_input(opt.in_path, cap, meta, err);
+        if (open_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return open_code;
+        }
+        file_fps = meta.fps_out;
+    }
+    else
+    {
+        cap.open(opt.cam);
+        if (!cap.isOpened())
+        {
+            fmt::println(stderr, "Cannot open the camera");
+            return cvtool::core::ExitCode::CannotOpenOrReadInput;
+        }
+        cap.set(cv::CAP_PROP_FPS, 60);
+        cap.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'));
+        cap.set(cv::CAP_PROP_BUFFERSIZE, 1);
     }
-    cap.set(cv::CAP_PROP_FPS, 60);
-    cap.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'));
-    cap.set(cv::CAP_PROP_BUFFERSIZE, 1);
 
     int width, height;
     if (!opt.size_str.empty())
@@ -148,21 +507,55 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
             fmt::println(stderr, "{}", err);
             return sr_code;
         }
-        cap.set(cv::CAP_PROP_FRAME_WIDTH, width);
-        cap.set(cv::CAP_PROP_FRAME_HEIGHT, height);
+        if (from_file)
+        {
+            fmt::println(stderr, "warning: --size is ignored when reading from --in");
+        }
+        else
+        {
+            cap.set(cv::CAP_PROP_FRAME_WIDTH, width);
+            cap.set(cv::CAP_PROP_FRAME_HEIGHT, height);
+        }
+    }
+    startup.camera_ms = elapsed_ms(camera_start);
+
+    // Rules go first: they register the gesture IDs the image map may refer to.
+    cvtool::core::gesture::GestureRuleTable rule_table;
+    const cvtool::core::gesture::GestureRuleTable *rules{nullptr};
+    if (!opt.rules_path.empty())
+    {
+        auto rules_code = cvtool::core::gesture::load_gesture_rules(opt.rules_path, rule_table, err);
+        if (rules_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return rules_code;
+        }
+        rules = &rule_table;
     }
 
+    constexpr int gesture_w = 256;
+    constexpr int gesture_h = 200;
+
+    const auto bank_start = std::chrono::steady_clock::now();
     cvtool::core::gesture::GestureImageBank bank;
-    auto bank_code = cvtool::core::gesture::load_gesture_image_bank(
-        opt.map_path, bank, warnings, err);
-    if (bank_code != cvtool::core::ExitCode::Ok)
+    if (!opt.headless)
     {
-        fmt::println(stderr, "{}", err);
-        return bank_code;
+        cvtool::core::gesture::GestureBankOptions bank_options;
+        bank_options.display_size = cv::Size(gesture_w, gesture_h);
+        bank_options.max_bytes = static_cast<std::size_t>(opt.bank_cache_mb) * 1024 * 1024;
+
+        auto bank_code = cvtool::core::gesture::load_gesture_image_bank(
+            opt.map_path, bank, warnings, err, bank_options);
+        if (bank_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return bank_code;
+        }
+        else
+            for (auto &i : warnings)
+                fmt::println(stderr, "{}", i);
     }
-    else
-        for (auto &i : warnings)
-            fmt::println(stderr, "{}", i);
+    startup.bank_ms = elapsed_ms(bank_start);
 
     cv::Rect roi;
     bool roi_enable{false};
@@ -177,8 +570,6 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
         roi_enable = true;
     }
 
-    cv::Mat frame;
-    int read_fail_streak{0};
     std::string winname{"MyVideo"};
     std::string gesture_winname{"Gesture"};
     cvtool::core::ExitCode exit_code = cvtool::core::ExitCode::Ok;
@@ -186,11 +577,8 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
     bool window_initialized{false};
     bool roi_warned{false};
 
-    constexpr int gesture_w = 256;
-    constexpr int gesture_h = 200;
-
     int frame_index{0};
-    const int hand_infer_interval{2};
+    const int hand_infer_interval{opt.hand_interval};
     const int face_infer_interval{4};
     cvtool::core::gesture::HandLandmarkResult cached_hand_result{};
     cvtool::core::gesture::FaceLandmarkResult cached_face_result{};
@@ -205,13 +593,24 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
 
     auto display_gesture{cvtool::core::gesture::GestureID::None};
 
-    cvtool::core::gesture::HandLandmarkDetector hand_detector;
-    auto det_code = hand_detector.initialize(opt.hand_model_path, err);
+    const auto model_wait_start = std::chrono::steady_clock::now();
+    auto det_code = hand_task.get();
     if (det_code != cvtool::core::ExitCode::Ok)
     {
-        fmt::println(stderr, "{}", err);
+        fmt::println(stderr, "{}", hand_err);
         return det_code;
     }
+    if (with_face_model)
+    {
+        auto face_code = face_task.get();
+        if (face_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", face_err);
+            return face_code;
+        }
+    }
+    startup.model_wait_ms = elapsed_ms(model_wait_start);
+
     std::vector<std::pair<int, int>> connections{
         // Thumb
         {0, 1},
@@ -242,51 +641,97 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
         {0, 17}};
 
     cvtool::core::gesture::GestureStabilizer stabilizer{opt.stable_frames, opt.cooldown_ms};
+    cvtool::core::gesture::LandmarkFilter landmark_filter{opt.smooth_min_cutoff, opt.smooth_beta};
+
+    const bool multi_hand = opt.max_hands > 1;
+    cvtool::core::gesture::HandTrackerConfig tracker_cfg;
+    tracker_cfg.max_hands = opt.max_hands;
+    tracker_cfg.discovery_interval = opt.discovery_interval;
+    tracker_cfg.stable_frames = opt.stable_frames;
+    tracker_cfg.cooldown_ms = opt.cooldown_ms;
+    tracker_cfg.smooth = opt.smooth;
+    tracker_cfg.smooth_min_cutoff = opt.smooth_min_cutoff;
+    tracker_cfg.smooth_beta = opt.smooth_beta;
+    cvtool::core::gesture::HandTracker hand_tracker{tracker_cfg};
+
+    // File input is timestamped from the frame index, so the stabilizer cooldown
+    // behaves the same no matter how fast the frames are processed.
+    const auto stream_start = std::chrono::steady_clock::now();
+    const auto frame_clock = [&](int index)
+    {
+        if (!from_file)
+            return std::chrono::steady_clock::now();
 
-    cvtool::core::gesture::FaceLandmarkDetector face_detector;
-    if (!opt.face_model_path.empty())
+        return stream_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  std::chrono::duration<double>(index / file_fps));
+    };
+
+    cvtool::core::gesture::LandmarkRecorder recorder;
+    if (!opt.record_path.empty())
     {
-        auto face_code = face_detector.initialize(opt.face_model_path, err);
-        if (face_code != cvtool::core::ExitCode::Ok)
+        const auto record_code = recorder.open(opt.record_path, opt.max_hands, err);
+        if (record_code != cvtool::core::ExitCode::Ok)
         {
             fmt::println(stderr, "{}", err);
-            return face_code;
+            return record_code;
         }
     }
 
+    // Live cameras drop the oldest queued frame when processing falls behind;
+    // files block the reader instead so no frame is skipped.
+    constexpr std::size_t capture_ring_slots = 3;
+    cvtool::core::FrameCapture capture{cap, capture_ring_slots, !from_file};
+    cvtool::core::CapturedFrame captured;
+    StageHistograms histograms;
+    const auto capture_start = std::chrono::steady_clock::now();
+    capture.start();
+
     while (true)
     {
-        bool bSuccess = cap.read(frame);
-        if (!bSuccess)
+        const auto capture_status = capture.next(captured, std::chrono::milliseconds(100));
+        if (capture_status == cvtool::core::CaptureStatus::End)
         {
-            read_fail_streak++;
-            fmt::println(stderr, "warning: failed to read frame");
-            if (read_fail_streak >= 15)
+            if (capture.failed())
             {
                 fmt::println(stderr, "error: camera died");
                 exit_code = cvtool::core::ExitCode::CannotOpenOrReadInput;
-                break;
             }
-            int fail_key = cv::waitKey(100);
-            if (fail_key == 27 || fail_key == 'q' || fail_key == 'Q')
+            else if (from_file && frame_index == 0)
+            {
+                fmt::println(stderr, "error: cannot read frames from video: {}", opt.in_path);
+                exit_code = cvtool::core::ExitCode::CannotOpenOrReadInput;
+            }
+            break;
+        }
+        if (capture_status == cvtool::core::CaptureStatus::Timeout)
+        {
+            if (opt.headless || !window_initialized)
+                continue;
+
+            int wait_key = cv::waitKey(1);
+            if (wait_key == 27 || wait_key == 'q' || wait_key == 'Q')
             {
-                fmt::println("User aborted during camera failure");
+                fmt::println("User aborted while waiting for a frame");
                 break;
             }
-            if (window_initialized)
+            if (cv::getWindowProperty(winname, cv::WND_PROP_VISIBLE) < 1.0 ||
+                cv::getWindowProperty(gesture_winname, cv::WND_PROP_VISIBLE) < 1.0)
             {
-                if (cv::getWindowProperty(winname, cv::WND_PROP_VISIBLE) < 1.0 ||
-                    cv::getWindowProperty(gesture_winname, cv::WND_PROP_VISIBLE) < 1.0)
-                {
-                    fmt::println("Window closed by user during camera failure");
-                    break;
-                }
+                fmt::println("Window closed by user while waiting for a frame");
+                break;
             }
             continue;
         }
-        read_fail_streak = 0;
 
-        if (!window_initialized)
+        cv::Mat &frame = captured.image;
+        const auto frame_start = std::chrono::steady_clock::now();
+        FrameTimings timings;
+        if (frame_index == 0)
+            startup.first_capture_ms = std::chrono::duration<double, std::milli>(frame_start - capture_start).count();
+        timings.queue_ms =
+            std::chrono::duration<double, std::milli>(frame_start - captured.captured_at).count();
+
+        if (!window_initialized && !opt.headless)
         {
             int win_w = frame.cols;
             int win_h = frame.rows;
@@ -301,7 +746,7 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
 
             if (bank.fallback.empty())
             {
-                bank.fallback = cv::Mat::zeros(frame.rows, frame.cols, CV_8UC3);
+                bank.fallback = cv::Mat::zeros(gesture_h, gesture_w, CV_8UC3);
             }
         }
 
@@ -331,27 +776,61 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
         }
 
         frame_index++;
+        const auto frame_now = frame_clock(frame_index);
+
         const bool run_hand_now{
             has_valid_roi &&
-            (((frame_index % hand_infer_interval) == 1) || !cached_hand_result.has_hand)};
+            (hand_infer_interval == 1 ||
+             ((frame_index % hand_infer_interval) == 1) ||
+             (multi_hand ? hand_tracker.needs_inference() : !cached_hand_result.has_hand))};
 
         const bool run_face_now{
             has_valid_roi &&
             (((frame_index % face_infer_interval) == 1) || !cached_face_result.has_face)};
 
         bool hand_updated_this_frame{false};
+        bool hand_predicted_this_frame{false};
+        bool face_ran_this_frame{false};
         if (has_valid_roi)
         {
-            if (run_hand_now)
+            if (multi_hand)
             {
+                const auto hand_start = std::chrono::steady_clock::now();
+                hand_tracker.update(hand_detector, frame, safe_roi, run_hand_now, frame_now);
+                if (run_hand_now)
+                    timings.hand_ms = elapsed_ms(hand_start);
+
+                for (const auto &track : hand_tracker.tracks())
+                {
+                    hand_updated_this_frame = hand_updated_this_frame || track.updated;
+                    hand_predicted_this_frame = hand_predicted_this_frame || track.predicted;
+                }
+                hand_updated_this_frame = hand_updated_this_frame || run_hand_now;
+            }
+            else if (run_hand_now)
+            {
+                const auto hand_start = std::chrono::steady_clock::now();
                 cached_hand_result = hand_detector.detect(frame, safe_roi);
+                if (opt.smooth)
+                    cached_hand_result = landmark_filter.update(cached_hand_result, frame_now);
+                timings.hand_ms = elapsed_ms(hand_start);
                 hand_updated_this_frame = true;
             }
+            else if (opt.smooth && landmark_filter.has_state())
+            {
+                cached_hand_result = landmark_filter.predict(frame_now);
+                hand_predicted_this_frame = true;
+            }
 
             if (opt.enable_contextual_gestures)
             {
                 if (run_face_now)
+                {
+                    const auto face_start = std::chrono::steady_clock::now();
                     cached_face_result = face_detector.detect(frame, safe_roi);
+                    timings.face_ms = elapsed_ms(face_start);
+                    face_ran_this_frame = true;
+                }
             }
             else
                 cached_face_result = {};
@@ -360,80 +839,154 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
         {
             cached_hand_result = {};
             cached_face_result = {};
+            landmark_filter.reset();
+            hand_tracker.reset();
         }
 
-        if (hand_updated_this_frame)
+        const auto classify_start = std::chrono::steady_clock::now();
+        if (multi_hand && has_valid_roi)
         {
-            if (cvtool::core::gesture::can_classify_hand(cached_hand_result))
+            auto &tracks = hand_tracker.tracks();
+            for (auto &track : tracks)
             {
-                cached_raw_gesture =
-                    cvtool::core::gesture::classify_hand_gesture(cached_hand_result);
-
-                if (opt.enable_contextual_gestures)
+                if (track.updated || track.predicted)
                 {
-                    auto ctx_gesture = cvtool::core::gesture::classify_contextual_gesture(
-                        cached_hand_result, cached_face_result);
-
-                    if (ctx_gesture != cvtool::core::gesture::GestureID::None &&
-                        ctx_gesture != cvtool::core::gesture::GestureID::Unknown &&
-                        (cached_raw_gesture.gesture == cvtool::core::gesture::GestureID::Unknown ||
-                         cached_raw_gesture.gesture == cvtool::core::gesture::GestureID::Fist))
-                    {
-                        cached_raw_gesture.gesture = ctx_gesture;
-                    }
+                    classify_and_stabilize(
+                        track.hand, cached_face_result, opt.enable_contextual_gestures, rules,
+                        track.stabilizer, frame_now, track.raw_gesture, track.stab_res,
+                        timings.stabilize_ms);
                 }
+            }
 
-                cached_stab_res = stabilizer.update(cached_raw_gesture.gesture,
-                                                    std::chrono::steady_clock::now());
-
-                cached_debug_fingers_str = fmt::format(
-                    "T={} I={} M={} R={} P={}",
-                    cached_raw_gesture.state.thumb_extended ? 1 : 0,
-                    cached_raw_gesture.state.index_extended ? 1 : 0,
-                    cached_raw_gesture.state.middle_extended ? 1 : 0,
-                    cached_raw_gesture.state.ring_extended ? 1 : 0,
-                    cached_raw_gesture.state.pinky_extended ? 1 : 0);
+            // The gesture window and the single-hand fields follow the oldest track.
+            if (!tracks.empty())
+            {
+                cached_hand_result = tracks.front().hand;
+                cached_raw_gesture = tracks.front().raw_gesture;
+                cached_stab_res = tracks.front().stab_res;
+                cached_debug_fingers_str = cvtool::core::gesture::can_classify_hand(cached_hand_result)
+                                               ? fingers_to_string(cached_raw_gesture.state)
+                                               : "None";
             }
-            else
+            else if (hand_updated_this_frame)
             {
+                cached_hand_result = {};
                 cached_raw_gesture = {cvtool::core::gesture::GestureID::None, {}};
-
-                cached_stab_res = stabilizer.update(cvtool::core::gesture::GestureID::None,
-                                                    std::chrono::steady_clock::now());
-
+                cached_stab_res = stabilizer.update(cvtool::core::gesture::GestureID::None, frame_now);
                 cached_debug_fingers_str = "None";
             }
         }
+        else if (hand_updated_this_frame || hand_predicted_this_frame)
+        {
+            const bool classified = classify_and_stabilize(
+                cached_hand_result, cached_face_result, opt.enable_contextual_gestures, rules,
+                stabilizer, frame_now, cached_raw_gesture, cached_stab_res,
+                timings.stabilize_ms);
+
+            cached_debug_fingers_str = classified ? fingers_to_string(cached_raw_gesture.state) : "None";
+        }
         else if (!has_valid_roi)
         {
             cached_raw_gesture = {
                 cvtool::core::gesture::GestureID::None, {}};
 
             cached_stab_res = stabilizer.update(
-                cvtool::core::gesture::GestureID::None,
-                std::chrono::steady_clock::now());
+                cvtool::core::gesture::GestureID::None, frame_now);
 
             cached_debug_fingers_str = "None";
         }
+        timings.classify_ms = elapsed_ms(classify_start) - timings.stabilize_ms;
 
         display_gesture = cached_stab_res.stable_gesture;
 
+        if (recorder.is_open())
+        {
+            cvtool::core::gesture::LandmarkRecord record;
+            record.t_ms = std::chrono::duration<double, std::milli>(frame_now - stream_start).count();
+            record.frame = static_cast<std::uint32_t>(frame_index);
+            record.valid_roi = has_valid_roi ? 1 : 0;
+            record.hand_updated = hand_updated_this_frame ? 1 : 0;
+            record.face = cvtool::core::gesture::to_recorded_face(cached_face_result);
+
+            if (multi_hand)
+            {
+                for (const auto &track : hand_tracker.tracks())
+                {
+                    if (record.hand_count >= cvtool::core::gesture::landmark_record_max_hands)
+                        break;
+                    record.hands[record.hand_count++] = cvtool::core::gesture::to_recorded_hand(
+                        track.hand, track.id, track.updated, track.predicted);
+                }
+            }
+            else
+            {
+                record.hands[0] = cvtool::core::gesture::to_recorded_hand(
+                    cached_hand_result, -1, hand_updated_this_frame, hand_predicted_this_frame);
+                record.hand_count = 1;
+            }
+
+            if (recorder.write(record, err) != cvtool::core::ExitCode::Ok)
+            {
+                fmt::println(stderr, "{}", err);
+                exit_code = cvtool::core::ExitCode::CannotWriteOutput;
+                break;
+            }
+        }
+
+        if (opt.headless)
+        {
+            timings.frame_ms = elapsed_ms(frame_start);
+            timings.latency_ms = elapsed_ms(captured.captured_at);
+            record_frame_timings(histograms, timings, run_hand_now, face_ran_this_frame, false);
+            if (frame_index == 1)
+            {
+                startup.first_inference_ms = timings.hand_ms + timings.face_ms;
+                print_startup_report(elapsed_ms(startup_start), startup, hand_detector,
+                                     with_face_model ? &face_detector : nullptr);
+            }
+            const double t_ms =
+                std::chrono::duration<double, std::milli>(frame_now - stream_start).count();
+
+            fmt::println("{}", frame_to_json(
+                                   frame_index, t_ms,
+                                   cached_hand_result, cached_face_result,
+                                   cached_raw_gesture.gesture, cached_stab_res,
+                                   hand_updated_this_frame, hand_predicted_this_frame,
+                                   multi_hand ? &hand_tracker.tracks() : nullptr, timings)
+                                   .dump());
+            continue;
+        }
+
+        const auto display_start = std::chrono::steady_clock::now();
         cv::Mat display_frame = frame;
 
         if (has_valid_roi && roi_enable)
             cv::rectangle(display_frame, safe_roi, cv::Scalar(0, 255, 0), 2);
 
-        if (cvtool::core::gesture::can_classify_hand(cached_hand_result))
+        if (multi_hand)
+        {
+            for (const auto &track : hand_tracker.tracks())
+            {
+                if (!cvtool::core::gesture::can_classify_hand(track.hand))
+                    continue;
+
+                draw_hand_landmarks(display_frame, track.hand, connections);
+                cv::putText(display_frame,
+                            fmt::format("#{} {}", track.id,
+                                        cvtool::core::gesture::to_debug_label(track.stab_res.stable_gesture)),
+                            cv::Point(track.hand.hand_bbox.x, std::max(15, track.hand.hand_bbox.y - 8)),
+                            cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 255, 0), 1,
+                            cv::LINE_AA);
+            }
+        }
+        else if (cvtool::core::gesture::can_classify_hand(cached_hand_result))
             draw_hand_landmarks(display_frame, cached_hand_result, connections);
 
         if (cached_display_image.empty() ||
             cached_display_image_gesture != display_gesture)
         {
-            const cv::Mat &raw_img =
-                cvtool::core::gesture::get_gesture_image(bank, display_gesture);
-
             cached_display_image =
-                cvtool::core::gesture::letterbox(raw_img, gesture_w, gesture_h);
+                cvtool::core::gesture::get_gesture_image(bank, display_gesture);
 
             cached_display_image_gesture = display_gesture;
         }
@@ -447,7 +1000,10 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
                 cached_stab_res,
                 cached_hand_result.confidence,
                 cached_debug_fingers_str,
-                cached_face_result);
+                cached_face_result,
+                capture.stats(),
+                elapsed_ms(captured.captured_at),
+                histograms);
 
             if (cached_face_result.has_face)
             {
@@ -464,6 +1020,18 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
         cv::imshow(gesture_winname, cached_display_image);
 
         int key{cv::waitKey(5)};
+
+        timings.display_ms = elapsed_ms(display_start);
+        timings.latency_ms = elapsed_ms(captured.captured_at);
+        timings.frame_ms = elapsed_ms(frame_start);
+        record_frame_timings(histograms, timings, run_hand_now, face_ran_this_frame, true);
+        if (frame_index == 1)
+        {
+            startup.first_inference_ms = timings.hand_ms + timings.face_ms;
+            print_startup_report(elapsed_ms(startup_start), startup, hand_detector,
+                                 with_face_model ? &face_detector : nullptr);
+        }
+
         if (key == 27 || key == 'q' || key == 'Q')
         {
             fmt::println("Stop key pressed by user");
@@ -472,6 +1040,8 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
         else if (key == 'r' || key == 'R')
         {
             stabilizer.reset();
+            landmark_filter.reset();
+            hand_tracker.reset();
         }
 
         if (cv::getWindowProperty(winname, cv::WND_PROP_VISIBLE) < 1.0 ||
@@ -482,8 +1052,48 @@ cvtool::core::ExitCode run_gesture_show(const cvtool::cmd::GestureShowOptions &o
         }
     }
 
+    capture.stop();
+
+    if (recorder.close(err) != cvtool::core::ExitCode::Ok)
+    {
+        fmt::println(stderr, "{}", err);
+        if (exit_code == cvtool::core::ExitCode::Ok)
+            exit_code = cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    if (opt.headless && frame_index > 0)
+    {
+        const double total_ms = elapsed_ms(stream_start);
+        fmt::println(stderr,
+                     "frames: {}\n"
+                     "dropped: {}\n"
+                     "time_ms: {:.1f}\n"
+                     "fps: {:.2f}",
+                     frame_index,
+                     capture.stats().dropped,
+                     total_ms,
+                     total_ms > 0.0 ? frame_index * 1000.0 / total_ms : 0.0);
+    }
+
     cap.release();
-    cv::destroyAllWindows();
+    if (window_initialized)
+        cv::destroyAllWindows();
+
+    if (histograms[StageEndToEnd].count() > 0)
+    {
+        print_latency_summary(histograms);
+
+        if (!opt.latency_out_path.empty())
+        {
+            const auto report_code = write_latency_report(opt.latency_out_path, histograms, err);
+            if (report_code != cvtool::core::ExitCode::Ok)
+            {
+                fmt::println(stderr, "{}", err);
+                if (exit_code == cvtool::core::ExitCode::Ok)
+                    exit_code = report_code;
+            }
+        }
+    }
 
     return exit_code;
 }
@@ -1,6 +1,7 @@
 #include "cvtool/commands/gray.hpp"
 #include "cvtool/core/validate.hpp"
 #include "cvtool/core/image_io.hpp"
+#include "cvtool/core/strip_processing.hpp"
 
 #include <opencv2/imgproc.hpp>
 
@@ -33,15 +34,32 @@ cvtool::core::ExitCode run_gray(const cvtool::cmd::GrayOptions &opt)
     }
     
 
-    cv::Mat gray;
-    try
+    const auto to_gray = [channels](const cv::Mat &src, cv::Mat &dst)
     {
         if (channels == 1){
-            gray = img.clone();
+            dst = src.clone();
         } else if (channels == 3){
-            cv::cvtColor(img, gray, cv::COLOR_BGR2GRAY);
+            cv::cvtColor(src, dst, cv::COLOR_BGR2GRAY);
         } else if (channels == 4){
-            cv::cvtColor(img, gray, cv::COLOR_BGRA2GRAY);
+            cv::cvtColor(src, dst, cv::COLOR_BGRA2GRAY);
+        }
+    };
+
+    cv::Mat gray;
+    try
+    {
+        if (opt.strip_rows > 0)
+        {
+            const auto strips_code = cvtool::core::process_in_strips(img, gray, CV_8UC1, opt.strip_rows, 0, to_gray, err);
+            if (strips_code != cvtool::core::ExitCode::Ok)
+            {
+                fmt::println(stderr, "{}", err);
+                return strips_code;
+            }
+        }
+        else
+        {
+            to_gray(img, gray);
         }
     }
     catch (const cv::Exception &e)
@@ -61,6 +79,9 @@ cvtool::core::ExitCode run_gray(const cvtool::cmd::GrayOptions &opt)
         return write_code;
     }
 
+    if (opt.quiet)
+        return cvtool::core::ExitCode::Ok;
+
     fmt::println(
         "command: gray\n"
         "in: {}\n"
@@ -1,37 +1,123 @@
 #include "cvtool/commands/info.hpp"
 #include "cvtool/core/exit_codes.hpp"
+#include "cvtool/core/image_probe.hpp"
+#include "cvtool/core/columnar.hpp"
 
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/videoio.hpp>
 #include <opencv2/core.hpp>
 
+#include <nlohmann/json.hpp>
+
 #include <fmt/format.h>
 
+#include <array>
 #include <filesystem>
+#include <fstream>
 
 
-static void print_image_info(const std::filesystem::path &path, const cv::Mat &img)
+static void print_image_info(const std::filesystem::path &path, const cvtool::core::ImageHeader &header, bool json)
 {
-    const char *depth_str = cv::depthToString(img.depth());
-    const std::string type_str = cv::typeToString(img.type());
+    const int type = CV_MAKETYPE(header.depth, header.channels);
+    const char *depth_str = cv::depthToString(header.depth);
+    const std::string type_str = cv::typeToString(type);
+
+    if (json)
+    {
+        nlohmann::ordered_json j;
+        j["kind"] = "image";
+        j["path"] = path.string();
+        j["format"] = header.format;
+        j["width"] = header.width;
+        j["height"] = header.height;
+        j["channels"] = header.channels;
+        j["depth"] = depth_str;
+        j["mat_type"] = type_str;
+        fmt::println("{}", j.dump());
+        return;
+    }
 
     fmt::println(
         "kind: image\n"
         "path: {}\n"
+        "format: {}\n"
         "size: {}x{}\n"
         "channels: {}\n"
         "depth: {} ({})\n"
         "mat_type: {}",
         path.string(),
-        img.cols,
-        img.rows,
-        img.channels(),
+        header.format,
+        header.width,
+        header.height,
+        header.channels,
         depth_str,
-        img.depth(),
+        header.depth,
         type_str);
 }
 
-static cvtool::core::ExitCode print_video_info(const std::filesystem::path &path, cv::VideoCapture &cap)
+static const char *column_type_name(cvtool::core::columnar::ColumnType type)
+{
+    switch (type)
+    {
+    case cvtool::core::columnar::ColumnType::Int32:
+        return "i32";
+    case cvtool::core::columnar::ColumnType::Float32:
+        return "f32";
+    case cvtool::core::columnar::ColumnType::Float64:
+        return "f64";
+    }
+    return "unknown";
+}
+
+static bool looks_columnar(const std::string &path)
+{
+    std::array<unsigned char, sizeof(cvtool::core::columnar::FileHeader)> head{};
+    std::ifstream file(path, std::ios::binary);
+    file.read(reinterpret_cast<char *>(head.data()), static_cast<std::streamsize>(head.size()));
+    return file.gcount() == static_cast<std::streamsize>(head.size()) &&
+           cvtool::core::columnar::is_columnar(head.data(), head.size());
+}
+
+static cvtool::core::ExitCode print_columnar_info(const std::filesystem::path &path, bool json)
+{
+    cvtool::core::columnar::ColumnarReader reader;
+    std::string err;
+    const auto open_code = reader.open(path.string(), err);
+    if (open_code != cvtool::core::ExitCode::Ok)
+    {
+        fmt::println(stderr, "{}", err);
+        return open_code;
+    }
+
+    if (json)
+    {
+        nlohmann::ordered_json j;
+        j["kind"] = "columnar";
+        j["path"] = path.string();
+        j["tables"] = nlohmann::ordered_json::array();
+        for (const auto &t : reader.tables())
+        {
+            nlohmann::ordered_json columns = nlohmann::ordered_json::array();
+            for (const auto &c : t.columns)
+                columns.push_back({{"name", c.name}, {"type", column_type_name(c.type)}});
+            j["tables"].push_back({{"name", t.name}, {"rows", t.rows}, {"columns", columns}});
+        }
+        fmt::println("{}", j.dump());
+        return cvtool::core::ExitCode::Ok;
+    }
+
+    fmt::println("kind: columnar\npath: {}", path.string());
+    for (const auto &t : reader.tables())
+    {
+        std::string columns;
+        for (const auto &c : t.columns)
+            columns += fmt::format("{}{}:{}", columns.empty() ? "" : " ", c.name, column_type_name(c.type));
+        fmt::println("table: {} rows: {} columns: {}", t.name, t.rows, columns);
+    }
+    return cvtool::core::ExitCode::Ok;
+}
+
+static cvtool::core::ExitCode print_video_info(const std::filesystem::path &path, cv::VideoCapture &cap, bool json)
 {
     const int w = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH));
     const int h = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT));
@@ -43,6 +129,20 @@ static cvtool::core::ExitCode print_video_info(const std::filesystem::path &path
     const bool frames_known = frames > 0;
     const bool duration_known = fps_known && frames_known;
 
+    if (json)
+    {
+        nlohmann::ordered_json j;
+        j["kind"] = "video";
+        j["path"] = path.string();
+        j["width"] = w;
+        j["height"] = h;
+        j["fps"] = fps_known ? nlohmann::ordered_json(fps) : nlohmann::ordered_json(nullptr);
+        j["frames"] = frames_known ? nlohmann::ordered_json(static_cast<long long>(frames)) : nlohmann::ordered_json(nullptr);
+        j["duration_s"] = duration_known ? nlohmann::ordered_json(frames / fps) : nlohmann::ordered_json(nullptr);
+        fmt::println("{}", j.dump());
+        return cvtool::core::ExitCode::Ok;
+    }
+
     const std::string fps_str = fps_known ? fmt::format("{:.2f}", fps) : "unknown";
     const std::string frames_str =
         frames_known ? fmt::format("{}", static_cast<long long>(frames)) : "unknown";
@@ -89,12 +189,25 @@ cvtool::core::ExitCode run_info(const cvtool::cmd::InfoOptions &opt)
         return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
     }
 
+    if (looks_columnar(opt.in_path))
+        return print_columnar_info(opt.in_path, opt.json);
+
+    // Common image formats are described from their header alone; only unknown
+    // formats (and headers we cannot interpret exactly) pay for a full decode.
+    cvtool::core::ImageHeader header;
+    std::string probe_err;
+    if (cvtool::core::probe_image_header(opt.in_path, header, probe_err) == cvtool::core::ExitCode::Ok)
+    {
+        print_image_info(opt.in_path, header, opt.json);
+        return cvtool::core::ExitCode::Ok;
+    }
+
     try
     {
         cv::Mat img = cv::imread(opt.in_path, cv::IMREAD_UNCHANGED);
         if (!img.empty())
         {
-            print_image_info(opt.in_path, img);
+            print_image_info(opt.in_path, {"other", img.cols, img.rows, img.channels(), img.depth()}, opt.json);
             return cvtool::core::ExitCode::Ok;
         }
     }
@@ -109,7 +222,7 @@ cvtool::core::ExitCode run_info(const cvtool::cmd::InfoOptions &opt)
         cv::VideoCapture cap(opt.in_path);
         if (cap.isOpened())
         {
-            return print_video_info(opt.in_path, cap);
+            return print_video_info(opt.in_path, cap, opt.json);
         }
     }
     catch (const cv::Exception &e)
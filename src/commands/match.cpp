@@ -10,6 +10,7 @@
 #include "cvtool/core/match/match_search_ms.hpp"
 #include "cvtool/core/match/match_prepare.hpp"
 #include "cvtool/commands/match_validate.hpp"
+#include "cvtool/core/columnar.hpp"
 
 #include <opencv2/imgproc.hpp>
 
@@ -21,6 +22,38 @@
 #include <cmath>
 #include <array>
 
+// "matches" holds one row per kept hit, "rois" the regions that were searched.
+static cvtool::core::ExitCode write_match_columnar(
+    const std::string &path,
+    const std::vector<cvtool::core::templ_match::MatchBest> &hits,
+    const std::vector<cv::Rect> &rois,
+    std::string &err)
+{
+    cvtool::core::columnar::Table m;
+    m.name = "matches";
+    m.rows = hits.size();
+    m.add_column<std::int32_t>("id", [](std::size_t r) { return static_cast<std::int32_t>(r); });
+    m.add_column<std::int32_t>("x", [&](std::size_t r) { return hits[r].bbox.x; });
+    m.add_column<std::int32_t>("y", [&](std::size_t r) { return hits[r].bbox.y; });
+    m.add_column<std::int32_t>("w", [&](std::size_t r) { return hits[r].bbox.width; });
+    m.add_column<std::int32_t>("h", [&](std::size_t r) { return hits[r].bbox.height; });
+    m.add_column<double>("raw_score", [&](std::size_t r) { return hits[r].raw_score; });
+    m.add_column<double>("confidence", [&](std::size_t r) { return hits[r].confidence; });
+    m.add_column<double>("scale", [&](std::size_t r) { return hits[r].scale; });
+    m.add_column<std::int32_t>("templ_w", [&](std::size_t r) { return hits[r].template_size.width; });
+    m.add_column<std::int32_t>("templ_h", [&](std::size_t r) { return hits[r].template_size.height; });
+
+    cvtool::core::columnar::Table t;
+    t.name = "rois";
+    t.rows = rois.size();
+    t.add_column<std::int32_t>("x", [&](std::size_t r) { return rois[r].x; });
+    t.add_column<std::int32_t>("y", [&](std::size_t r) { return rois[r].y; });
+    t.add_column<std::int32_t>("w", [&](std::size_t r) { return rois[r].width; });
+    t.add_column<std::int32_t>("h", [&](std::size_t r) { return rois[r].height; });
+
+    return cvtool::core::columnar::write_columnar(path, {m, t}, err);
+}
+
 cvtool::core::ExitCode run_match(const cvtool::cmd::MatchOptions &opt)
 {
     cv::Mat scene, templ;
@@ -251,6 +284,15 @@ cvtool::core::ExitCode run_match(const cvtool::cmd::MatchOptions &opt)
             return json_code;
         }
     }
+    if (!opt.bin_path.empty())
+    {
+        const auto bin_code = write_match_columnar(opt.bin_path, hits_topk, search_rois, err);
+        if (bin_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return bin_code;
+        }
+    }
 
     cv::Mat vis;
 
@@ -0,0 +1,464 @@
+#include "cvtool/commands/quantize_model.hpp"
+#include "cvtool/core/image_io.hpp"
+#include "cvtool/core/gesture/hand_landmark_detector.hpp"
+#include "cvtool/core/gesture/face_landmark_detector.hpp"
+#include "cvtool/core/gesture/gesture_rules.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct HandDelta
+{
+    int fp32_hands{0};
+    int int8_hands{0};
+    int presence_agree{0};
+    int both{0};
+    double err_sum_px{0.0};
+    double err_max_px{0.0};
+    int gesture_total{0};
+    int gesture_agree{0};
+    double fp32_ms{0.0};
+    double int8_ms{0.0};
+};
+
+struct FaceDelta
+{
+    int fp32_faces{0};
+    int int8_faces{0};
+    int presence_agree{0};
+    int both{0};
+    double iou_sum{0.0};
+    double mouth_err_sum_px{0.0};
+    double mouth_err_max_px{0.0};
+    double fp32_ms{0.0};
+    double int8_ms{0.0};
+};
+
+double elapsed_ms(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+double safe_div(double a, int b)
+{
+    return b > 0 ? a / static_cast<double>(b) : 0.0;
+}
+
+cvtool::core::ExitCode list_frames(
+    const std::string &frames_dir, int max_frames, std::vector<std::filesystem::path> &out, std::string &err)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(frames_dir, ec))
+    {
+        err = fmt::format("error: frames folder does not exist or is not a directory: {}", frames_dir);
+        return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
+    }
+
+    for (const auto &entry : std::filesystem::directory_iterator(frames_dir, ec))
+    {
+        if (!entry.is_regular_file())
+            continue;
+
+        std::string ext = entry.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp")
+            out.push_back(entry.path());
+    }
+    if (ec)
+    {
+        err = fmt::format("error: cannot list frames folder: {} ({})", frames_dir, ec.message());
+        return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
+    }
+
+    std::sort(out.begin(), out.end());
+    if (max_frames > 0 && static_cast<int>(out.size()) > max_frames)
+    {
+        // Spread the calibration set over the whole folder instead of taking the first N frames.
+        std::vector<std::filesystem::path> picked;
+        picked.reserve(max_frames);
+        const double step = static_cast<double>(out.size()) / static_cast<double>(max_frames);
+        for (int i = 0; i < max_frames; i++)
+            picked.push_back(out[static_cast<std::size_t>(i * step)]);
+        out.swap(picked);
+    }
+
+    if (out.empty())
+    {
+        err = fmt::format("error: no .jpg/.png/.bmp frames found in: {}", frames_dir);
+        return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+// NumPy .npy v1.0, little-endian float32, C order.
+cvtool::core::ExitCode write_npy(const std::filesystem::path &path, const cv::Mat &blob, std::string &err)
+{
+    if (blob.empty() || blob.type() != CV_32F || !blob.isContinuous())
+    {
+        err = fmt::format("error: cannot export calibration tensor: {}", path.string());
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    std::string shape;
+    for (int i = 0; i < blob.dims; i++)
+        shape += fmt::format("{}, ", blob.size[i]);
+    if (blob.dims == 1)
+        shape.pop_back();
+    else
+        shape.resize(shape.size() - 2);
+
+    std::string header = fmt::format("{{'descr': '<f4', 'fortran_order': False, 'shape': ({}), }}", shape);
+    const std::size_t unpadded = 10 + header.size() + 1;
+    header.append((64 - unpadded % 64) % 64, ' ');
+    header.push_back('\n');
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        err = fmt::format("error: cannot write calibration tensor: {}", path.string());
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    const std::uint16_t header_len = static_cast<std::uint16_t>(header.size());
+    const char magic[8] = {'\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0};
+    file.write(magic, sizeof(magic));
+    file.put(static_cast<char>(header_len & 0xff));
+    file.put(static_cast<char>(header_len >> 8));
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char *>(blob.ptr<float>()),
+               static_cast<std::streamsize>(blob.total() * sizeof(float)));
+
+    if (!file)
+    {
+        err = fmt::format("error: cannot write calibration tensor: {}", path.string());
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+nlohmann::ordered_json blob_shape(const cv::Mat &blob)
+{
+    nlohmann::ordered_json shape = nlohmann::ordered_json::array();
+    for (int i = 0; i < blob.dims; i++)
+        shape.push_back(blob.size[i]);
+    return shape;
+}
+
+void compare_hands(
+    const cvtool::core::gesture::HandLandmarkResult &fp32,
+    const cvtool::core::gesture::HandLandmarkResult &int8,
+    HandDelta &delta)
+{
+    delta.fp32_hands += fp32.has_hand ? 1 : 0;
+    delta.int8_hands += int8.has_hand ? 1 : 0;
+    delta.presence_agree += (fp32.has_hand == int8.has_hand) ? 1 : 0;
+
+    if (!fp32.has_hand || !int8.has_hand)
+        return;
+
+    delta.both++;
+    double err_sum{0.0};
+    for (std::size_t i = 0; i < fp32.points.size(); i++)
+        err_sum += cvtool::core::gesture::distance(fp32.points[i], int8.points[i]);
+    const double mean_err = err_sum / static_cast<double>(fp32.points.size());
+    delta.err_sum_px += mean_err;
+    delta.err_max_px = std::max(delta.err_max_px, mean_err);
+
+    if (cvtool::core::gesture::can_classify_hand(fp32) && cvtool::core::gesture::can_classify_hand(int8))
+    {
+        delta.gesture_total++;
+        const auto g32 = cvtool::core::gesture::classify_hand_gesture(fp32).gesture;
+        const auto g8 = cvtool::core::gesture::classify_hand_gesture(int8).gesture;
+        delta.gesture_agree += (g32 == g8) ? 1 : 0;
+    }
+}
+
+void compare_faces(
+    const cvtool::core::gesture::FaceLandmarkResult &fp32,
+    const cvtool::core::gesture::FaceLandmarkResult &int8,
+    FaceDelta &delta)
+{
+    delta.fp32_faces += fp32.has_face ? 1 : 0;
+    delta.int8_faces += int8.has_face ? 1 : 0;
+    delta.presence_agree += (fp32.has_face == int8.has_face) ? 1 : 0;
+
+    if (!fp32.has_face || !int8.has_face)
+        return;
+
+    delta.both++;
+    const double inter = (fp32.bbox & int8.bbox).area();
+    const double uni = fp32.bbox.area() + int8.bbox.area() - inter;
+    delta.iou_sum += uni > 0.0 ? inter / uni : 0.0;
+
+    const double mouth_err = cvtool::core::gesture::distance(fp32.mouth_center, int8.mouth_center);
+    delta.mouth_err_sum_px += mouth_err;
+    delta.mouth_err_max_px = std::max(delta.mouth_err_max_px, mouth_err);
+}
+
+}
+
+cvtool::core::ExitCode run_quantize_model(const cvtool::cmd::QuantizeModelOptions &opt)
+{
+    std::string err;
+
+    if (!opt.int8_face_model_path.empty() && opt.face_model_path.empty())
+    {
+        fmt::println(stderr, "error: --int8-face-model requires --face-model");
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    std::vector<std::filesystem::path> frames;
+    const auto list_code = list_frames(opt.frames_dir, opt.max_frames, frames, err);
+    if (list_code != cvtool::core::ExitCode::Ok)
+    {
+        fmt::println(stderr, "{}", err);
+        return list_code;
+    }
+
+    const std::filesystem::path out_dir(opt.out_dir);
+    const bool with_face = !opt.face_model_path.empty();
+    std::error_code ec;
+    std::filesystem::create_directories(out_dir / "hand", ec);
+    if (!ec && with_face)
+        std::filesystem::create_directories(out_dir / "face", ec);
+    if (ec)
+    {
+        fmt::println(stderr, "error: cannot create output folder: {} ({})", opt.out_dir, ec.message());
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    cvtool::core::gesture::HandLandmarkDetector hand_fp32;
+    auto init_code = hand_fp32.initialize(opt.hand_model_path, err);
+    if (init_code != cvtool::core::ExitCode::Ok)
+    {
+        fmt::println(stderr, "{}", err);
+        return init_code;
+    }
+
+    cvtool::core::gesture::FaceLandmarkDetector face_fp32;
+    if (with_face)
+    {
+        init_code = face_fp32.initialize(opt.face_model_path, err, opt.face_input_size);
+        if (init_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return init_code;
+        }
+    }
+
+    const bool eval_hand = !opt.int8_hand_model_path.empty();
+    const bool eval_face = !opt.int8_face_model_path.empty();
+
+    cvtool::core::gesture::HandLandmarkDetector hand_int8;
+    if (eval_hand)
+    {
+        init_code = hand_int8.initialize(opt.int8_hand_model_path, err);
+        if (init_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return init_code;
+        }
+    }
+
+    cvtool::core::gesture::FaceLandmarkDetector face_int8;
+    if (eval_face)
+    {
+        init_code = face_int8.initialize(opt.int8_face_model_path, err, opt.face_input_size);
+        if (init_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return init_code;
+        }
+    }
+
+    // Keep lazy ORT initialization out of the fp32 / int8 latency comparison.
+    constexpr int warmup_runs = 2;
+    if (eval_hand &&
+        ((init_code = hand_fp32.warm_up(warmup_runs, err)) != cvtool::core::ExitCode::Ok ||
+         (init_code = hand_int8.warm_up(warmup_runs, err)) != cvtool::core::ExitCode::Ok))
+    {
+        fmt::println(stderr, "{}", err);
+        return init_code;
+    }
+    if (eval_face &&
+        ((init_code = face_fp32.warm_up(warmup_runs, err)) != cvtool::core::ExitCode::Ok ||
+         (init_code = face_int8.warm_up(warmup_runs, err)) != cvtool::core::ExitCode::Ok))
+    {
+        fmt::println(stderr, "{}", err);
+        return init_code;
+    }
+
+    fmt::println(
+        "command: quantize-model\n"
+        "frames: {} ({} used)\n"
+        "out: {}\n"
+        "hand model: {}\n"
+        "face model: {}",
+        opt.frames_dir, frames.size(),
+        opt.out_dir,
+        opt.hand_model_path,
+        with_face ? opt.face_model_path : "-");
+
+    nlohmann::ordered_json hand_files = nlohmann::ordered_json::array();
+    nlohmann::ordered_json face_files = nlohmann::ordered_json::array();
+    nlohmann::ordered_json hand_shape;
+    nlohmann::ordered_json face_shape;
+
+    HandDelta hand_delta{};
+    FaceDelta face_delta{};
+    int skipped{0};
+
+    for (std::size_t i = 0; i < frames.size(); i++)
+    {
+        cv::Mat frame;
+        if (cvtool::core::image_io::read_image(frames[i].string(), frame, err) != cvtool::core::ExitCode::Ok ||
+            frame.channels() != 3 || frame.depth() != CV_8U)
+        {
+            skipped++;
+            continue;
+        }
+
+        const std::string name = fmt::format("{:05}.npy", i);
+
+        const cv::Mat hand_blob = hand_fp32.input_blob(frame);
+        auto write_code = write_npy(out_dir / "hand" / name, hand_blob, err);
+        if (write_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return write_code;
+        }
+        hand_files.push_back("hand/" + name);
+        hand_shape = blob_shape(hand_blob);
+
+        if (with_face)
+        {
+            const cv::Mat face_blob = face_fp32.input_blob(frame);
+            write_code = write_npy(out_dir / "face" / name, face_blob, err);
+            if (write_code != cvtool::core::ExitCode::Ok)
+            {
+                fmt::println(stderr, "{}", err);
+                return write_code;
+            }
+            face_files.push_back("face/" + name);
+            face_shape = blob_shape(face_blob);
+        }
+
+        if (eval_hand)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            const auto r32 = hand_fp32.detect(frame);
+            hand_delta.fp32_ms += elapsed_ms(t0);
+
+            t0 = std::chrono::steady_clock::now();
+            const auto r8 = hand_int8.detect(frame);
+            hand_delta.int8_ms += elapsed_ms(t0);
+
+            compare_hands(r32, r8, hand_delta);
+        }
+
+        if (eval_face)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            const auto r32 = face_fp32.detect(frame);
+            face_delta.fp32_ms += elapsed_ms(t0);
+
+            t0 = std::chrono::steady_clock::now();
+            const auto r8 = face_int8.detect(frame);
+            face_delta.int8_ms += elapsed_ms(t0);
+
+            compare_faces(r32, r8, face_delta);
+        }
+    }
+
+    const int used = static_cast<int>(hand_files.size());
+    if (used == 0)
+    {
+        fmt::println(stderr, "error: none of the frames could be read as 8-bit BGR images");
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    nlohmann::ordered_json manifest;
+    manifest["format"] = "npy";
+    manifest["dtype"] = "float32";
+    manifest["hand"] = {
+        {"model", opt.hand_model_path},
+        {"input_name", "input"},
+        {"shape", hand_shape},
+        {"files", hand_files}};
+    if (with_face)
+    {
+        manifest["face"] = {
+            {"model", opt.face_model_path},
+            {"input_name", "input.1"},
+            {"shape", face_shape},
+            {"files", face_files}};
+    }
+
+    const std::filesystem::path manifest_path = out_dir / "calibration.json";
+    std::ofstream manifest_file(manifest_path);
+    if (!manifest_file)
+    {
+        fmt::println(stderr, "error: cannot write calibration manifest: {}", manifest_path.string());
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+    manifest_file << std::setw(4) << manifest << "\n";
+
+    fmt::println("calibration: {} frames exported, {} skipped, manifest: {}",
+                 used, skipped, manifest_path.string());
+
+    if (eval_hand)
+    {
+        fmt::println(
+            "hand int8 vs fp32: {}\n"
+            "  presence agreement: {:.1f}% (fp32 {} / int8 {} hands)\n"
+            "  landmark error: mean {:.2f} px, worst frame {:.2f} px ({} frames)\n"
+            "  gesture agreement: {:.1f}% ({} frames)\n"
+            "  latency: fp32 {:.2f} ms, int8 {:.2f} ms",
+            opt.int8_hand_model_path,
+            100.0 * safe_div(hand_delta.presence_agree, used), hand_delta.fp32_hands, hand_delta.int8_hands,
+            safe_div(hand_delta.err_sum_px, hand_delta.both), hand_delta.err_max_px, hand_delta.both,
+            100.0 * safe_div(hand_delta.gesture_agree, hand_delta.gesture_total), hand_delta.gesture_total,
+            safe_div(hand_delta.fp32_ms, used), safe_div(hand_delta.int8_ms, used));
+    }
+
+    if (eval_face)
+    {
+        fmt::println(
+            "face int8 vs fp32: {}\n"
+            "  presence agreement: {:.1f}% (fp32 {} / int8 {} faces)\n"
+            "  bbox IoU: mean {:.3f} ({} frames)\n"
+            "  mouth error: mean {:.2f} px, worst frame {:.2f} px\n"
+            "  latency: fp32 {:.2f} ms, int8 {:.2f} ms",
+            opt.int8_face_model_path,
+            100.0 * safe_div(face_delta.presence_agree, used), face_delta.fp32_faces, face_delta.int8_faces,
+            safe_div(face_delta.iou_sum, face_delta.both), face_delta.both,
+            safe_div(face_delta.mouth_err_sum_px, face_delta.both), face_delta.mouth_err_max_px,
+            safe_div(face_delta.fp32_ms, used), safe_div(face_delta.int8_ms, used));
+    }
+
+    if (!eval_hand && !eval_face)
+        fmt::println("next: quantize with onnxruntime.quantization.quantize_static (see README), "
+                     "then rerun with --int8-model/--int8-face-model for the accuracy report");
+
+    fmt::println("status: ok");
+
+    return cvtool::core::ExitCode::Ok;
+}
@@ -0,0 +1,109 @@
+#include "cvtool/commands/threshold_bench.hpp"
+#include "cvtool/core/image_io.hpp"
+#include "cvtool/core/threshold.hpp"
+#include "cvtool/core/validate.hpp"
+
+#include <opencv2/imgproc.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Median wall time of one make_binary_mask call, in milliseconds.
+static cvtool::core::ExitCode time_mode(
+    const cv::Mat &gray, const std::string &mode, int block, const cvtool::cmd::ThresholdBenchOptions &opt,
+    double &median_ms, std::string &err)
+{
+    std::vector<double> samples;
+    samples.reserve(static_cast<std::size_t>(opt.repeat));
+
+    cv::Mat bin;
+    for (int i = 0; i < opt.repeat; i++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto code = make_binary_mask(gray, mode, 0, false, block, opt.c, opt.k, opt.p, -1, {}, bin, err);
+        const auto end = std::chrono::steady_clock::now();
+        if (code != cvtool::core::ExitCode::Ok)
+            return code;
+
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    median_ms = samples[samples.size() / 2];
+    return cvtool::core::ExitCode::Ok;
+}
+
+cvtool::core::ExitCode run_threshold_bench(const cvtool::cmd::ThresholdBenchOptions &opt)
+{
+    std::string err;
+
+    for (const int block : opt.blocks)
+    {
+        const auto block_code = cvtool::core::validate::validate_adaptive_block(block, err);
+        if (block_code != cvtool::core::ExitCode::Ok)
+        {
+            fmt::println(stderr, "{}", err);
+            return block_code;
+        }
+    }
+
+    cv::Mat img;
+    const auto read_code = cvtool::core::image_io::read_image(opt.in_path, img, err);
+    if (read_code != cvtool::core::ExitCode::Ok)
+    {
+        fmt::println(stderr, "{}", err);
+        return read_code;
+    }
+
+    // Convert once so every mode is timed on the same 8-bit gray input.
+    cv::Mat gray;
+    if (img.channels() == 3)
+        cv::cvtColor(img, gray, cv::COLOR_BGR2GRAY);
+    else if (img.channels() == 4)
+        cv::cvtColor(img, gray, cv::COLOR_BGRA2GRAY);
+    else
+        gray = img;
+
+    if (gray.depth() != CV_8U)
+    {
+        cv::normalize(gray, gray, 0, 255, cv::NORM_MINMAX);
+        gray.convertTo(gray, CV_8U);
+    }
+
+    fmt::println(
+        "command: threshold-bench\n"
+        "in: {}\n"
+        "size: {}x{}\n"
+        "repeat: {}\n"
+        "threads: {}",
+        opt.in_path,
+        gray.cols, gray.rows,
+        opt.repeat,
+        cv::getNumThreads());
+
+    constexpr std::array<const char *, 4> modes{"adaptive", "adaptive-mean-fast", "bradley", "sauvola"};
+
+    for (const int block : opt.blocks)
+    {
+        std::string line = fmt::format("block: {:>3}", block);
+        for (const char *mode : modes)
+        {
+            double median_ms{0.0};
+            const auto code = time_mode(gray, mode, block, opt, median_ms, err);
+            if (code != cvtool::core::ExitCode::Ok)
+            {
+                fmt::println(stderr, "{}", err);
+                return code;
+            }
+            line += fmt::format("  {}: {:.2f} ms", mode, median_ms);
+        }
+        fmt::println("{}", line);
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
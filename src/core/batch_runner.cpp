@@ -0,0 +1,312 @@
+#include "cvtool/core/batch_runner.hpp"
+#include "cvtool/core/mapped_file.hpp"
+
+#include <opencv2/core/utility.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace cvtool::core
+{
+
+struct BatchItem
+{
+    std::filesystem::path in_path;
+    std::filesystem::path out_path;
+};
+
+static bool is_image_file(const std::filesystem::path &path)
+{
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    return ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp" ||
+           ext == ".tif" || ext == ".tiff" || ext == ".webp";
+}
+
+// relative: the input's path below the input folder, or a manifest entry. Entries
+// outside the current folder (absolute or starting with "..") keep their full
+// directory chain below out_dir, so equal file names in different folders stay apart.
+static std::filesystem::path output_path_for(const BatchOptions &opt, std::filesystem::path relative)
+{
+    if (relative.is_absolute() || (!relative.empty() && *relative.begin() == ".."))
+        relative = std::filesystem::absolute(relative).lexically_normal().relative_path();
+
+    std::filesystem::path out = std::filesystem::path(opt.out_dir) / relative;
+    if (!opt.out_ext.empty())
+        out.replace_extension(opt.out_ext);
+
+    return out;
+}
+
+static std::filesystem::path normalized(const std::filesystem::path &path)
+{
+    std::error_code ec;
+    const auto canonical = std::filesystem::weakly_canonical(path, ec);
+    return ec ? std::filesystem::absolute(path).lexically_normal() : canonical;
+}
+
+static cvtool::core::ExitCode collect_items(const BatchOptions &opt, std::vector<BatchItem> &items, std::string &err)
+{
+    std::error_code ec;
+
+    if (!opt.in_dir.empty())
+    {
+        const std::filesystem::path root(opt.in_dir);
+        // An --out-dir inside --in-dir holds earlier outputs; walking into it would feed
+        // them back as inputs and nest one level deeper on every rerun.
+        const std::filesystem::path out_root = normalized(opt.out_dir);
+        for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (it->is_directory(ec) && normalized(it->path()) == out_root)
+            {
+                it.disable_recursion_pending();
+                continue;
+            }
+
+            if (!it->is_regular_file(ec) || !is_image_file(it->path()))
+                continue;
+
+            items.push_back({it->path(), output_path_for(opt, it->path().lexically_relative(root))});
+        }
+        if (ec)
+        {
+            err = fmt::format("error: cannot list input folder: {} ({})", opt.in_dir, ec.message());
+            return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
+        }
+
+        std::sort(items.begin(), items.end(),
+                  [](const BatchItem &a, const BatchItem &b) { return a.in_path < b.in_path; });
+        return cvtool::core::ExitCode::Ok;
+    }
+
+    std::ifstream manifest(opt.manifest_path);
+    if (!manifest)
+    {
+        err = fmt::format("error: cannot open manifest: {}", opt.manifest_path);
+        return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
+    }
+
+    std::string line;
+    while (std::getline(manifest, line))
+    {
+        const auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+        const auto last = line.find_last_not_of(" \t\r");
+
+        const std::filesystem::path in_path(line.substr(first, last - first + 1));
+        items.push_back({in_path, output_path_for(opt, in_path.lexically_normal())});
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+// Two inputs writing the same output, or an output replacing an input, would
+// silently lose data, so the whole batch is refused before anything runs.
+static cvtool::core::ExitCode check_output_paths(const std::vector<BatchItem> &items, std::string &err)
+{
+    std::set<std::filesystem::path> inputs;
+    for (const auto &item : items)
+        inputs.insert(normalized(item.in_path));
+
+    std::map<std::filesystem::path, const BatchItem *> outputs;
+    for (const auto &item : items)
+    {
+        const auto out = normalized(item.out_path);
+        if (inputs.count(out) > 0)
+        {
+            err = fmt::format("error: output would overwrite an input: {} (use another --out-dir or --out-ext)",
+                              item.out_path.string());
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+
+        const auto [it, inserted] = outputs.emplace(out, &item);
+        if (!inserted)
+        {
+            err = fmt::format("error: {} and {} would both write {}",
+                              it->second->in_path.string(), item.in_path.string(), item.out_path.string());
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+cvtool::core::ExitCode run_batch(const std::string &command, const BatchOptions &opt, const BatchJob &job)
+{
+    std::string err;
+    std::vector<BatchItem> items;
+
+    auto collect_code = collect_items(opt, items, err);
+    if (collect_code != cvtool::core::ExitCode::Ok)
+    {
+        fmt::println(stderr, "{}", err);
+        return collect_code;
+    }
+    if (items.empty())
+    {
+        fmt::println(stderr, "error: no input images found in {}",
+                     opt.in_dir.empty() ? opt.manifest_path : opt.in_dir);
+        return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
+    }
+
+    const auto paths_code = check_output_paths(items, err);
+    if (paths_code != cvtool::core::ExitCode::Ok)
+    {
+        fmt::println(stderr, "{}", err);
+        return paths_code;
+    }
+
+    std::unordered_set<std::string> finished;
+    if (!opt.checkpoint_path.empty())
+    {
+        std::ifstream checkpoint_in(opt.checkpoint_path);
+        std::string line;
+        while (std::getline(checkpoint_in, line))
+        {
+            if (!line.empty())
+                finished.insert(line);
+        }
+    }
+
+    std::vector<const BatchItem *> pending;
+    pending.reserve(items.size());
+    std::set<std::filesystem::path> out_dirs;
+    for (const auto &item : items)
+    {
+        if (finished.count(item.in_path.generic_string()) > 0)
+            continue;
+
+        pending.push_back(&item);
+        out_dirs.insert(item.out_path.parent_path());
+    }
+
+    for (const auto &dir : out_dirs)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        if (ec)
+        {
+            fmt::println(stderr, "error: cannot create output folder: {} ({})", dir.string(), ec.message());
+            return cvtool::core::ExitCode::CannotWriteOutput;
+        }
+    }
+
+    std::ofstream checkpoint_out;
+    if (!opt.checkpoint_path.empty())
+    {
+        checkpoint_out.open(opt.checkpoint_path, std::ios::app);
+        if (!checkpoint_out)
+        {
+            fmt::println(stderr, "error: cannot open checkpoint file: {}", opt.checkpoint_path);
+            return cvtool::core::ExitCode::CannotWriteOutput;
+        }
+    }
+
+    unsigned workers_count = opt.jobs > 0 ? static_cast<unsigned>(opt.jobs) : std::thread::hardware_concurrency();
+    workers_count = std::clamp(workers_count, 1u, static_cast<unsigned>(std::max<std::size_t>(pending.size(), 1)));
+
+    // Parallelism comes from the image pool; nested OpenCV threads would only oversubscribe the cores.
+    const int cv_threads = cv::getNumThreads();
+    if (workers_count > 1)
+        cv::setNumThreads(1);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<std::size_t> next_item{0};
+    std::atomic<std::size_t> done{0};
+    std::atomic<std::size_t> failed{0};
+    std::mutex mutex;
+    cvtool::core::ExitCode first_failure{cvtool::core::ExitCode::Ok};
+
+    const auto worker = [&]()
+    {
+        for (std::size_t i = next_item++; i < pending.size(); i = next_item++)
+        {
+            const BatchItem &item = *pending[i];
+
+            // Start reading the image this worker will most likely take next while this one decodes.
+            if (i + workers_count < pending.size())
+                prefetch_file(pending[i + workers_count]->in_path.string());
+
+            const auto code = job(item.in_path.string(), item.out_path.string());
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (code == cvtool::core::ExitCode::Ok)
+            {
+                if (checkpoint_out.is_open())
+                    checkpoint_out << item.in_path.generic_string() << '\n' << std::flush;
+            }
+            else
+            {
+                failed++;
+                if (first_failure == cvtool::core::ExitCode::Ok)
+                    first_failure = code;
+                fmt::println(stderr, "error: {} failed (exit code {})", item.in_path.string(), static_cast<int>(code));
+            }
+
+            const std::size_t finished_now = ++done;
+            if (finished_now % 1000 == 0)
+            {
+                const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                fmt::println(stderr, "progress: {}/{} ({:.1f} images/s)",
+                             finished_now, pending.size(), seconds > 0.0 ? finished_now / seconds : 0.0);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workers_count - 1);
+    for (unsigned t = 1; t < workers_count; t++)
+        workers.emplace_back(worker);
+    worker();
+    for (auto &w : workers)
+        w.join();
+
+    cv::setNumThreads(cv_threads);
+
+    const double total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const std::size_t processed = done - failed;
+
+    fmt::println(
+        "command: {} (batch)\n"
+        "in: {}\n"
+        "out: {}\n"
+        "jobs: {}\n"
+        "images: {}\n"
+        "skipped: {}\n"
+        "processed: {}\n"
+        "failed: {}\n"
+        "time_ms: {:.1f}\n"
+        "images_per_s: {:.1f}\n"
+        "status: {}",
+        command,
+        opt.in_dir.empty() ? opt.manifest_path : opt.in_dir,
+        opt.out_dir,
+        workers_count,
+        items.size(),
+        items.size() - pending.size(),
+        processed,
+        failed.load(),
+        total_ms,
+        total_ms > 0.0 ? done * 1000.0 / total_ms : 0.0,
+        failed == 0 ? "ok" : "failed");
+
+    return first_failure;
+}
+
+}
@@ -0,0 +1,225 @@
+#include "cvtool/core/columnar.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+namespace cvtool::core::columnar
+{
+
+static_assert(std::endian::native == std::endian::little, "columnar files are written in native little-endian layout");
+
+static std::array<char, 16> fixed_name(const std::string &name)
+{
+    std::array<char, 16> out{};
+    std::memcpy(out.data(), name.data(), std::min(name.size(), out.size() - 1));
+    return out;
+}
+
+static std::string from_fixed_name(const std::array<char, 16> &name)
+{
+    return std::string(name.data(), strnlen(name.data(), name.size()));
+}
+
+// Size of one value of a known column type, 0 for anything else.
+static std::uint32_t value_size_of(ColumnType type)
+{
+    switch (type)
+    {
+    case ColumnType::Int32:
+        return sizeof(std::int32_t);
+    case ColumnType::Float32:
+        return sizeof(float);
+    case ColumnType::Float64:
+        return sizeof(double);
+    }
+    return 0;
+}
+
+static std::uint64_t align_up(std::uint64_t v)
+{
+    return (v + columnar_alignment - 1) / columnar_alignment * columnar_alignment;
+}
+
+cvtool::core::ExitCode write_columnar(const std::string &path, const std::vector<Table> &tables, std::string &err)
+{
+    FileHeader file_header;
+    file_header.table_count = static_cast<std::uint32_t>(tables.size());
+
+    std::vector<TableHeader> table_headers;
+    std::vector<ColumnHeader> column_headers;
+    for (const auto &t : tables)
+    {
+        TableHeader th;
+        th.name = fixed_name(t.name);
+        th.row_count = t.rows;
+        th.column_count = static_cast<std::uint32_t>(t.columns.size());
+        th.first_column = static_cast<std::uint32_t>(column_headers.size());
+        table_headers.push_back(th);
+
+        for (const auto &c : t.columns)
+        {
+            ColumnHeader ch;
+            ch.name = fixed_name(c.name);
+            ch.type = c.type;
+            ch.value_size = c.value_size;
+            column_headers.push_back(ch);
+        }
+    }
+
+    std::uint64_t offset = sizeof(FileHeader) + table_headers.size() * sizeof(TableHeader) +
+                           column_headers.size() * sizeof(ColumnHeader);
+    {
+        std::size_t ci{0};
+        for (const auto &t : tables)
+        {
+            for (std::size_t c = 0; c < t.columns.size(); c++, ci++)
+            {
+                offset = align_up(offset);
+                column_headers[ci].offset = offset;
+                offset += static_cast<std::uint64_t>(t.rows) * t.columns[c].value_size;
+            }
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        err = fmt::format("error: cannot open binary output '{}'", path);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    file.write(reinterpret_cast<const char *>(&file_header), sizeof(file_header));
+    file.write(reinterpret_cast<const char *>(table_headers.data()),
+               static_cast<std::streamsize>(table_headers.size() * sizeof(TableHeader)));
+    file.write(reinterpret_cast<const char *>(column_headers.data()),
+               static_cast<std::streamsize>(column_headers.size() * sizeof(ColumnHeader)));
+
+    // Columns are gathered from the row structs a chunk at a time.
+    constexpr std::size_t chunk_rows = 4096;
+    std::vector<unsigned char> chunk(chunk_rows * sizeof(double));
+    const char zeros[columnar_alignment]{};
+    std::uint64_t written = sizeof(FileHeader) + table_headers.size() * sizeof(TableHeader) +
+                            column_headers.size() * sizeof(ColumnHeader);
+
+    std::size_t ci{0};
+    for (const auto &t : tables)
+    {
+        for (const auto &c : t.columns)
+        {
+            const std::uint64_t target = column_headers[ci++].offset;
+            file.write(zeros, static_cast<std::streamsize>(target - written));
+            written = target;
+
+            for (std::size_t first = 0; first < t.rows; first += chunk_rows)
+            {
+                const std::size_t count = std::min(chunk_rows, t.rows - first);
+                for (std::size_t r = 0; r < count; r++)
+                    c.get(first + r, chunk.data() + r * c.value_size);
+
+                file.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(count * c.value_size));
+                written += count * c.value_size;
+            }
+        }
+    }
+
+    file.flush();
+    if (!file.good())
+    {
+        err = fmt::format("error: failed to write binary output: {}", path);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+bool is_columnar(const unsigned char *data, std::size_t size)
+{
+    return data != nullptr && size >= sizeof(FileHeader) &&
+           std::memcmp(data, columnar_magic.data(), columnar_magic.size()) == 0;
+}
+
+const ColumnView *TableView::column(const std::string &column_name) const
+{
+    const auto it = std::find_if(columns.begin(), columns.end(),
+                                 [&](const ColumnView &c) { return c.name == column_name; });
+    return it != columns.end() ? &*it : nullptr;
+}
+
+const TableView *ColumnarReader::table(const std::string &table_name) const
+{
+    const auto it = std::find_if(tables_.begin(), tables_.end(),
+                                 [&](const TableView &t) { return t.name == table_name; });
+    return it != tables_.end() ? &*it : nullptr;
+}
+
+cvtool::core::ExitCode ColumnarReader::open(const std::string &path, std::string &err)
+{
+    tables_.clear();
+
+    const auto map_code = file_.open(path, err, false);
+    if (map_code != cvtool::core::ExitCode::Ok)
+        return map_code;
+
+    const unsigned char *data = file_.data();
+    const std::size_t size = file_.size();
+    const auto corrupt = [&]()
+    {
+        err = fmt::format("error: not a valid columnar file: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    };
+
+    if (!is_columnar(data, size))
+        return corrupt();
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != columnar_version)
+    {
+        err = fmt::format("error: unsupported columnar file version {}: {}", header.version, path);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    const std::uint64_t tables_end = sizeof(FileHeader) + std::uint64_t{header.table_count} * sizeof(TableHeader);
+    if (tables_end > size)
+        return corrupt();
+
+    for (std::uint32_t t = 0; t < header.table_count; t++)
+    {
+        TableHeader th;
+        std::memcpy(&th, data + sizeof(FileHeader) + t * sizeof(TableHeader), sizeof(th));
+
+        TableView view;
+        view.name = from_fixed_name(th.name);
+        view.rows = static_cast<std::size_t>(th.row_count);
+
+        for (std::uint32_t c = 0; c < th.column_count; c++)
+        {
+            const std::uint64_t at = tables_end + (std::uint64_t{th.first_column} + c) * sizeof(ColumnHeader);
+            if (at + sizeof(ColumnHeader) > size)
+                return corrupt();
+
+            ColumnHeader ch;
+            std::memcpy(&ch, data + at, sizeof(ch));
+            const std::uint32_t value_size = value_size_of(ch.type);
+            if (value_size == 0 || ch.value_size != value_size)
+                return corrupt();
+
+            // Written so that a huge row count or offset cannot wrap around.
+            if (ch.offset % columnar_alignment != 0 || ch.offset > size ||
+                th.row_count > (size - ch.offset) / value_size)
+                return corrupt();
+
+            view.columns.push_back({from_fixed_name(ch.name), ch.type, data + ch.offset});
+        }
+
+        tables_.push_back(std::move(view));
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+}
@@ -4,22 +4,388 @@
 #include <opencv2/imgproc.hpp>
 #include <opencv2/core/types.hpp>
 
+#include <opencv2/core/utility.hpp>
+
 #include <fmt/core.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+
 namespace cvtool::core::contours
 {
 
-cvtool::core::ExitCode find_contours_report(
+// Masks at least this large go through tiled component labeling instead of one findContours.
+static constexpr std::size_t labeling_min_pixels = std::size_t{4096} * 4096;
+static constexpr int labeling_tile = 1024;
+
+// A pixel of a tile edge: foreground label l > 0 as +l, background label l as -l.
+using EdgeCode = std::int32_t;
+
+struct TileLabels
+{
+    cv::Rect rect;
+    int fg_count{0}; // local foreground labels 1..fg_count (8-connected)
+    int bg_count{0}; // local background labels 1..bg_count (4-connected)
+    std::vector<EdgeCode> top, bottom, left, right;
+    std::vector<std::int64_t> area;        // per foreground label - 1
+    std::vector<cv::Rect> bbox;            // image coordinates
+    std::vector<cv::Point> first;          // topmost-leftmost pixel, image coordinates
+    std::vector<std::uint64_t> touches;    // (fg label << 32) | bg label, 4-adjacent inside the tile
+};
+
+struct DisjointSets
+{
+    std::vector<std::int32_t> parent;
+
+    explicit DisjointSets(std::size_t n) : parent(n)
+    {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    std::int32_t find(std::int32_t x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    void unite(std::int32_t a, std::int32_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a != b)
+            parent[std::max(a, b)] = std::min(a, b);
+    }
+};
+
+static bool raster_before(const cv::Point &a, const cv::Point &b)
+{
+    return a.y < b.y || (a.y == b.y && a.x < b.x);
+}
+
+// Labels foreground (8-connected) and background (4-connected) of one tile. Only
+// per-label statistics, the edge pixels and the fg/bg adjacencies are kept; the
+// tile-sized label images are dropped when the tile is done.
+static void label_tile(const cv::Mat &bin, TileLabels &t)
+{
+    cv::Mat fg;
+    cv::compare(bin(t.rect), 0, fg, cv::CMP_NE);
+    cv::Mat bg;
+    cv::bitwise_not(fg, bg);
+
+    cv::Mat fg_labels, fg_stats, centroids, bg_labels;
+    t.fg_count = cv::connectedComponentsWithStats(fg, fg_labels, fg_stats, centroids, 8, CV_32S, cv::CCL_DEFAULT) - 1;
+    t.bg_count = cv::connectedComponents(bg, bg_labels, 4, CV_32S, cv::CCL_DEFAULT) - 1;
+
+    t.area.resize(t.fg_count);
+    t.bbox.resize(t.fg_count);
+    t.first.assign(t.fg_count, cv::Point(-1, -1));
+    for (int l = 1; l <= t.fg_count; l++)
+    {
+        const int *row = fg_stats.ptr<int>(l);
+        t.area[l - 1] = row[cv::CC_STAT_AREA];
+        t.bbox[l - 1] = cv::Rect(row[cv::CC_STAT_LEFT] + t.rect.x, row[cv::CC_STAT_TOP] + t.rect.y,
+                                 row[cv::CC_STAT_WIDTH], row[cv::CC_STAT_HEIGHT]);
+    }
+
+    const int w = t.rect.width;
+    const int h = t.rect.height;
+    std::uint64_t last_touch = ~std::uint64_t{0};
+    const auto touch = [&](int fg_label, int bg_label)
+    {
+        const std::uint64_t key = (static_cast<std::uint64_t>(fg_label) << 32) | static_cast<std::uint32_t>(bg_label);
+        if (key != last_touch)
+            t.touches.push_back(key);
+        last_touch = key;
+    };
+
+    // Each 4-adjacent pair is looked at once, from its left or upper pixel.
+    for (int y = 0; y < h; y++)
+    {
+        const int *f = fg_labels.ptr<int>(y);
+        const int *b = bg_labels.ptr<int>(y);
+        const int *f_down = y + 1 < h ? fg_labels.ptr<int>(y + 1) : nullptr;
+        const int *b_down = y + 1 < h ? bg_labels.ptr<int>(y + 1) : nullptr;
+
+        for (int x = 0; x < w; x++)
+        {
+            if (f[x] > 0)
+            {
+                if (t.first[f[x] - 1].x < 0)
+                    t.first[f[x] - 1] = cv::Point(x + t.rect.x, y + t.rect.y);
+                if (x + 1 < w && f[x + 1] == 0)
+                    touch(f[x], b[x + 1]);
+                if (f_down != nullptr && f_down[x] == 0)
+                    touch(f[x], b_down[x]);
+            }
+            else
+            {
+                if (x + 1 < w && f[x + 1] > 0)
+                    touch(f[x + 1], b[x]);
+                if (f_down != nullptr && f_down[x] > 0)
+                    touch(f_down[x], b[x]);
+            }
+        }
+    }
+
+    std::sort(t.touches.begin(), t.touches.end());
+    t.touches.erase(std::unique(t.touches.begin(), t.touches.end()), t.touches.end());
+
+    const auto code = [&](int y, int x) -> EdgeCode
+    {
+        const int l = fg_labels.at<int>(y, x);
+        return l > 0 ? l : -bg_labels.at<int>(y, x);
+    };
+    t.top.resize(w);
+    t.bottom.resize(w);
+    for (int x = 0; x < w; x++)
+    {
+        t.top[x] = code(0, x);
+        t.bottom[x] = code(h - 1, x);
+    }
+    t.left.resize(h);
+    t.right.resize(h);
+    for (int y = 0; y < h; y++)
+    {
+        t.left[y] = code(y, 0);
+        t.right[y] = code(y, w - 1);
+    }
+}
+
+// RETR_EXTERNAL contours are the 8-connected foreground components that touch the
+// outer background: the 4-connected background reachable from the image border
+// (findContours' zero frame); anything else sits in a hole of another component.
+// Tiles are labeled concurrently and stitched across tile borders with union-find,
+// so only tile-sized label buffers exist and area, bbox and the start pixel of each
+// component come out of the labeling. Components whose bbox could hold min_area
+// are traced, each on its own crop, in parallel.
+static void find_external_by_labeling(
     const cv::Mat &bin,
     double min_area,
     std::vector<ContourItem> &items,
-    ContourStats &stats,
-    std::string &err)
+    ContourStats &stats)
 {
-    items.clear();
-    stats = cvtool::core::contours::ContourStats{};
-    err.clear();
+    const int tiles_x = (bin.cols + labeling_tile - 1) / labeling_tile;
+    const int tiles_y = (bin.rows + labeling_tile - 1) / labeling_tile;
+
+    std::vector<TileLabels> tiles(static_cast<std::size_t>(tiles_x) * tiles_y);
+    for (int ty = 0; ty < tiles_y; ty++)
+    {
+        for (int tx = 0; tx < tiles_x; tx++)
+        {
+            const int x = tx * labeling_tile;
+            const int y = ty * labeling_tile;
+            tiles[ty * tiles_x + tx].rect =
+                cv::Rect(x, y, std::min(labeling_tile, bin.cols - x), std::min(labeling_tile, bin.rows - y));
+        }
+    }
+
+    cv::parallel_for_(cv::Range(0, static_cast<int>(tiles.size())), [&](const cv::Range &range)
+    {
+        for (int i = range.start; i < range.end; i++)
+            label_tile(bin, tiles[i]);
+    });
+
+    // Global node ids: each tile's foreground labels, then its background labels.
+    std::vector<std::int64_t> base(tiles.size() + 1, 0);
+    for (std::size_t i = 0; i < tiles.size(); i++)
+        base[i + 1] = base[i] + tiles[i].fg_count + tiles[i].bg_count;
+    CV_Assert(base.back() < std::numeric_limits<std::int32_t>::max());
+
+    const auto node_count = static_cast<std::int32_t>(base.back());
+    const std::int32_t outside = node_count;
+    DisjointSets sets(static_cast<std::size_t>(node_count) + 1);
+
+    const auto fg_node = [&](std::size_t tile, int label) { return static_cast<std::int32_t>(base[tile] + label - 1); };
+    const auto bg_node = [&](std::size_t tile, int label)
+    {
+        return static_cast<std::int32_t>(base[tile] + tiles[tile].fg_count + label - 1);
+    };
+
+    std::vector<std::pair<std::int32_t, std::int32_t>> touches; // (fg node, bg node)
+    for (std::size_t i = 0; i < tiles.size(); i++)
+    {
+        for (const auto key : tiles[i].touches)
+            touches.emplace_back(fg_node(i, static_cast<int>(key >> 32)), bg_node(i, static_cast<int>(key & 0xffffffffu)));
+        std::vector<std::uint64_t>().swap(tiles[i].touches);
+    }
+
+    // A full image row or column made of tile edges, as signed nodes (background: -(node + 1)).
+    using Line = std::vector<std::int64_t>;
+    const auto signed_node = [&](std::size_t tile, EdgeCode c) -> std::int64_t
+    {
+        return c > 0 ? fg_node(tile, c) : -static_cast<std::int64_t>(bg_node(tile, -c)) - 1;
+    };
+    const auto row_line = [&](int ty, bool bottom)
+    {
+        Line line;
+        line.reserve(bin.cols);
+        for (int tx = 0; tx < tiles_x; tx++)
+        {
+            const std::size_t i = static_cast<std::size_t>(ty) * tiles_x + tx;
+            for (const EdgeCode c : bottom ? tiles[i].bottom : tiles[i].top)
+                line.push_back(signed_node(i, c));
+        }
+        return line;
+    };
+    const auto column_line = [&](int tx, bool right)
+    {
+        Line line;
+        line.reserve(bin.rows);
+        for (int ty = 0; ty < tiles_y; ty++)
+        {
+            const std::size_t i = static_cast<std::size_t>(ty) * tiles_x + tx;
+            for (const EdgeCode c : right ? tiles[i].right : tiles[i].left)
+                line.push_back(signed_node(i, c));
+        }
+        return line;
+    };
+
+    // Two neighbouring lines across a tile border: foreground joins 8-connected,
+    // background 4-connected, and a straight fg/bg pair is an adjacency.
+    const auto stitch = [&](const Line &a, const Line &b)
+    {
+        const int n = static_cast<int>(a.size());
+        for (int k = 0; k < n; k++)
+        {
+            for (int d = -1; d <= 1; d++)
+            {
+                if (k + d < 0 || k + d >= n)
+                    continue;
+
+                const std::int64_t u = a[k];
+                const std::int64_t v = b[k + d];
+                if (u >= 0 && v >= 0)
+                    sets.unite(static_cast<std::int32_t>(u), static_cast<std::int32_t>(v));
+                else if (d != 0)
+                    continue;
+                else if (u < 0 && v < 0)
+                    sets.unite(static_cast<std::int32_t>(-u - 1), static_cast<std::int32_t>(-v - 1));
+                else if (u >= 0)
+                    touches.emplace_back(static_cast<std::int32_t>(u), static_cast<std::int32_t>(-v - 1));
+                else
+                    touches.emplace_back(static_cast<std::int32_t>(v), static_cast<std::int32_t>(-u - 1));
+            }
+        }
+    };
+    for (int ty = 0; ty + 1 < tiles_y; ty++)
+        stitch(row_line(ty, true), row_line(ty + 1, false));
+    for (int tx = 0; tx + 1 < tiles_x; tx++)
+        stitch(column_line(tx, true), column_line(tx + 1, false));
+
+    // The image border touches the zero frame outside it.
+    for (const Line &line : {row_line(0, false), row_line(tiles_y - 1, true),
+                             column_line(0, false), column_line(tiles_x - 1, true)})
+    {
+        for (const std::int64_t u : line)
+        {
+            if (u >= 0)
+                touches.emplace_back(static_cast<std::int32_t>(u), outside);
+            else
+                sets.unite(static_cast<std::int32_t>(-u - 1), outside);
+        }
+    }
+
+    struct Component
+    {
+        std::int64_t area{0};
+        cv::Rect bbox;
+        cv::Point first;
+        bool external{false};
+    };
+
+    std::vector<std::int32_t> slot(static_cast<std::size_t>(node_count), -1);
+    std::vector<Component> components;
+    for (std::size_t i = 0; i < tiles.size(); i++)
+    {
+        for (int l = 1; l <= tiles[i].fg_count; l++)
+        {
+            const std::int32_t root = sets.find(fg_node(i, l));
+            if (slot[root] < 0)
+            {
+                slot[root] = static_cast<std::int32_t>(components.size());
+                components.push_back({tiles[i].area[l - 1], tiles[i].bbox[l - 1], tiles[i].first[l - 1], false});
+                continue;
+            }
+
+            Component &c = components[slot[root]];
+            c.area += tiles[i].area[l - 1];
+            c.bbox |= tiles[i].bbox[l - 1];
+            if (raster_before(tiles[i].first[l - 1], c.first))
+                c.first = tiles[i].first[l - 1];
+        }
+    }
+    tiles.clear();
+
+    const std::int32_t outside_root = sets.find(outside);
+    for (const auto &[fg, bg] : touches)
+    {
+        if (sets.find(bg) == outside_root)
+            components[slot[sets.find(fg)]].external = true;
+    }
+
+    // contourArea runs through pixel centres, so it never exceeds (w - 1) * (h - 1).
+    std::vector<const Component *> candidates;
+    for (const auto &c : components)
+    {
+        if (!c.external)
+            continue;
+
+        stats.contours_total++;
+        if ((c.bbox.width - 1.0) * (c.bbox.height - 1.0) >= min_area)
+            candidates.push_back(&c);
+    }
+
+    // The crop may hold parts of other components; ours is the external contour
+    // that starts at its topmost-leftmost pixel, which is where findContours starts.
+    std::vector<ContourItem> traced(candidates.size());
+    cv::parallel_for_(cv::Range(0, static_cast<int>(candidates.size())), [&](const cv::Range &range)
+    {
+        for (int i = range.start; i < range.end; i++)
+        {
+            const Component &c = *candidates[i];
+
+            cv::Mat crop;
+            cv::compare(bin(c.bbox), 0, crop, cv::CMP_NE);
+
+            std::vector<std::vector<cv::Point>> contours;
+            cv::findContours(crop, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE, c.bbox.tl());
+            for (auto &contour : contours)
+            {
+                if (contour.empty() || contour[0] != c.first)
+                    continue;
+
+                traced[i].area = cv::contourArea(contour);
+                traced[i].bbox = c.bbox;
+                traced[i].contour = std::move(contour);
+                break;
+            }
+        }
+    });
+
+    // findContours lists external contours in descending raster order of their start point.
+    traced.erase(std::remove_if(traced.begin(), traced.end(),
+                                [&](const ContourItem &i) { return i.contour.empty() || i.area < min_area; }),
+                 traced.end());
+    std::sort(traced.begin(), traced.end(),
+              [](const ContourItem &a, const ContourItem &b) { return raster_before(b.contour[0], a.contour[0]); });
 
+    int kept_id{0};
+    for (auto &item : traced)
+    {
+        item.id = kept_id++;
+        items.push_back(std::move(item));
+    }
+}
+
+static cvtool::core::ExitCode validate_mask(const cv::Mat &bin, std::string &err)
+{
     if (bin.empty())
     {
         err = "error: input image is empty";
@@ -37,54 +403,84 @@ cvtool::core::ExitCode find_contours_report(
         return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
     }
 
-    try
-    {
-        cv::Mat tmp = bin.clone();
-        std::vector<std::vector<cv::Point>> contours;
-        cv::findContours(tmp, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+    return cvtool::core::ExitCode::Ok;
+}
 
-        stats.contours_total = static_cast<int>(contours.size());
+static void summarize_areas(const std::vector<ContourItem> &items, ContourStats &stats)
+{
+    stats.contours_kept = static_cast<int>(items.size());
 
-        int kept_id{0};
-        for (const auto &i : contours)
+    if (items.empty())
+    {
+        stats.area_min = 0.0;
+        stats.area_mean = 0.0;
+        stats.area_max = 0.0;       
+    }
+    else
+    {
+        double min_val = items[0].area;
+        double max_val = items[0].area;
+        double sum_val{0.0};
+
+        for (const auto &i : items)
         {
-            double area = cv::contourArea(i);
-            if (area >= min_area)
-            {
-                cv::Rect bbox = cv::boundingRect(i);
-                items.push_back({kept_id++, area, bbox, i});
-            }
+            if (min_val > i.area)
+                min_val = i.area;
+
+            if (max_val < i.area)
+                max_val = i.area;
+
+            sum_val += i.area;
         }
         
-        stats.contours_kept = static_cast<int>(items.size());
+        stats.area_min = min_val;
+        stats.area_max = max_val;
+        stats.area_mean = sum_val / static_cast<double>(items.size());
+    }
+}
+
+cvtool::core::ExitCode find_contours_report(
+    const cv::Mat &bin,
+    double min_area,
+    std::vector<ContourItem> &items,
+    ContourStats &stats,
+    std::string &err)
+{
+    items.clear();
+    stats = cvtool::core::contours::ContourStats{};
+    err.clear();
 
-        if (items.empty())
+    const auto mask_code = validate_mask(bin, err);
+    if (mask_code != cvtool::core::ExitCode::Ok)
+        return mask_code;
+
+    try
+    {
+        if (bin.total() >= labeling_min_pixels)
         {
-            stats.area_min = 0.0;
-            stats.area_mean = 0.0;
-            stats.area_max = 0.0;       
+            find_external_by_labeling(bin, min_area, items, stats);
         }
         else
         {
-            double min_val = items[0].area;
-            double max_val = items[0].area;
-            double sum_val{0.0};
+            cv::Mat tmp = bin.clone();
+            std::vector<std::vector<cv::Point>> contours;
+            cv::findContours(tmp, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
 
-            for (const auto &i : items)
-            {
-                if (min_val > i.area)
-                    min_val = i.area;
-
-                if (max_val < i.area)
-                    max_val = i.area;
+            stats.contours_total = static_cast<int>(contours.size());
 
-                sum_val += i.area;
+            int kept_id{0};
+            for (const auto &i : contours)
+            {
+                double area = cv::contourArea(i);
+                if (area >= min_area)
+                {
+                    cv::Rect bbox = cv::boundingRect(i);
+                    items.push_back({kept_id++, area, bbox, i});
+                }
             }
-            
-            stats.area_min = min_val;
-            stats.area_max = max_val;
-            stats.area_mean = sum_val / static_cast<double>(items.size());
         }
+
+        summarize_areas(items, stats);
     }
     catch(const cv::Exception &e)
     {
@@ -95,4 +491,51 @@ cvtool::core::ExitCode find_contours_report(
     return cvtool::core::ExitCode::Ok;
 }
 
-}
\ No newline at end of file
+cvtool::core::ExitCode find_components_report(
+    const cv::Mat &bin,
+    double min_area,
+    std::vector<ContourItem> &items,
+    ContourStats &stats,
+    std::string &err)
+{
+    items.clear();
+    stats = cvtool::core::contours::ContourStats{};
+    err.clear();
+
+    const auto mask_code = validate_mask(bin, err);
+    if (mask_code != cvtool::core::ExitCode::Ok)
+        return mask_code;
+
+    try
+    {
+        cv::Mat labels;
+        cv::Mat cc_stats;
+        cv::Mat centroids;
+        const int n = cv::connectedComponentsWithStats(bin, labels, cc_stats, centroids, 8, CV_32S, cv::CCL_DEFAULT);
+
+        stats.contours_total = n - 1;
+
+        int kept_id{0};
+        for (int label = 1; label < n; label++)
+        {
+            const int *row = cc_stats.ptr<int>(label);
+            const double area = row[cv::CC_STAT_AREA];
+            if (area < min_area)
+                continue;
+
+            const cv::Rect bbox(row[cv::CC_STAT_LEFT], row[cv::CC_STAT_TOP], row[cv::CC_STAT_WIDTH], row[cv::CC_STAT_HEIGHT]);
+            items.push_back({kept_id++, area, bbox, {}});
+        }
+
+        summarize_areas(items, stats);
+    }
+    catch(const cv::Exception &e)
+    {
+        err = fmt::format("OpenCV error in connectedComponentsWithStats: {}", e.what());
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+}
@@ -1,9 +1,16 @@
 #include "cvtool/core/edges_pipeline.hpp"
 #include "cvtool/core/validate.hpp"
+#include "cvtool/core/strip_processing.hpp"
 
 #include <opencv2/imgproc.hpp>
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace cvtool::core
 {
@@ -86,6 +93,185 @@ ExitCode edges_frame_to_gray(
     }
 }
 
+static void frame_to_gray(const cv::Mat &frame, cv::Mat &gray)
+{
+    if (frame.channels() == 1)
+        gray = frame.clone();
+    else if (frame.channels() == 3)
+        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    else if (frame.channels() == 4)
+        cv::cvtColor(frame, gray, cv::COLOR_BGRA2GRAY);
+}
+
+// Grows the strong pixels (2) of a 0/1/2 candidate map through 8-connected
+// candidates (1), exactly like Canny's hysteresis; edges end up 255, the rest 0.
+static void link_edges(cv::Mat &map)
+{
+    std::vector<std::uint8_t *> stack;
+    const int rows = map.rows;
+    const int cols = map.cols;
+    const auto step = static_cast<std::ptrdiff_t>(map.step);
+
+    for (int y = 0; y < rows; y++)
+    {
+        std::uint8_t *row = map.ptr<std::uint8_t>(y);
+        for (int x = 0; x < cols; x++)
+        {
+            if (row[x] != 2)
+                continue;
+
+            row[x] = 255;
+            stack.push_back(row + x);
+            while (!stack.empty())
+            {
+                std::uint8_t *p = stack.back();
+                stack.pop_back();
+
+                const std::ptrdiff_t offset = p - map.data;
+                const int py = static_cast<int>(offset / step);
+                const int px = static_cast<int>(offset % step);
+                for (int dy = -1; dy <= 1; dy++)
+                {
+                    if (py + dy < 0 || py + dy >= rows)
+                        continue;
+                    for (int dx = -1; dx <= 1; dx++)
+                    {
+                        if (px + dx < 0 || px + dx >= cols)
+                            continue;
+
+                        std::uint8_t *q = p + dy * step + dx;
+                        if (*q == 1)
+                        {
+                            *q = 255;
+                            stack.push_back(q);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    cv::threshold(map, map, 128, 255, cv::THRESH_BINARY);
+}
+
+ExitCode edges_frame_to_gray_in_strips(
+    const cv::Mat &frame,
+    int low,
+    int high,
+    int blur_k,
+    int strip_rows,
+    cv::Mat &out_gray,
+    std::string &err
+)
+{
+    if(frame.empty())
+    {
+        err = "error: input frame is empty";
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    auto v = cvtool::core::validate::validate_thresholds(low, high, err);
+    if (v != cvtool::core::ExitCode::Ok)
+        return v;
+
+    v = cvtool::core::validate::validate_blur_k(blur_k, err);
+    if (v != cvtool::core::ExitCode::Ok)
+        return v;
+
+    v = cvtool::core::validate::validate_gray_channels(frame.channels(), err);
+    if (v != cvtool::core::ExitCode::Ok)
+        return v;
+
+    if (strip_rows <= 0)
+    {
+        err = fmt::format("error: invalid strip size: {} rows", strip_rows);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    try
+    {
+        // Non-8-bit input is min/max normalized over the whole image, so the range is
+        // gathered first and each strip then applies cv::normalize's exact scale and shift.
+        double scale{1.0};
+        double shift{0.0};
+        const int depth = frame.depth();
+        if (depth != CV_8U)
+        {
+            double smin{DBL_MAX};
+            double smax{-DBL_MAX};
+            for (int y = 0; y < frame.rows; y += strip_rows)
+            {
+                cv::Mat gray;
+                frame_to_gray(frame.rowRange(y, std::min(y + strip_rows, frame.rows)), gray);
+
+                double lo{0.0};
+                double hi{0.0};
+                cv::minMaxIdx(gray, &lo, &hi);
+                smin = std::min(smin, lo);
+                smax = std::max(smax, hi);
+            }
+
+            scale = 255.0 * (smax - smin > DBL_EPSILON ? 1.0 / (smax - smin) : 0.0);
+            if (depth == CV_32F)
+            {
+                scale = static_cast<float>(scale);
+                shift = 0.0f - static_cast<float>(smin * scale);
+            }
+            else
+            {
+                shift = 0.0 - smin * scale;
+            }
+        }
+
+        // Blur radius, plus one row for the Sobel gradient and one for non-maximum suppression.
+        const int halo = blur_k / 2 + 2;
+
+        cv::Mat map;
+        const auto strips_code = cvtool::core::process_in_strips(
+            frame, map, CV_8UC1, strip_rows, halo,
+            [&](const cv::Mat &region, cv::Mat &dst)
+            {
+                cv::Mat gray;
+                frame_to_gray(region, gray);
+                if (depth != CV_8U)
+                {
+                    gray.convertTo(gray, depth, scale, shift);
+                    gray.convertTo(gray, CV_8U);
+                }
+
+                if (blur_k > 0)
+                    cv::GaussianBlur(gray, gray, cv::Size(blur_k, blur_k), 0);
+
+                // Non-maximum suppression does not depend on the thresholds, so every
+                // candidate is an edge at (low, low) and every seed one at (high, high).
+                cv::Mat candidates;
+                cv::Mat seeds;
+                cv::Canny(gray, candidates, low, low);
+                cv::Canny(gray, seeds, high, high);
+
+                cv::Mat weak;
+                cv::Mat strong;
+                cv::threshold(candidates, weak, 0, 1, cv::THRESH_BINARY);
+                cv::threshold(seeds, strong, 0, 1, cv::THRESH_BINARY);
+                cv::add(weak, strong, dst);
+            },
+            err);
+        if (strips_code != cvtool::core::ExitCode::Ok)
+            return strips_code;
+
+        link_edges(map);
+
+        out_gray = map;
+        err.clear();
+        return cvtool::core::ExitCode::Ok;
+    }
+    catch(const cv::Exception &e)
+    {
+        err = std::string("error: edges pipeline failed (") + e.what() + ")";
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+}
+
 ExitCode edges_frame_to_bgr(
     const cv::Mat &frame,
     int low, 
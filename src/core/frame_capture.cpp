@@ -0,0 +1,165 @@
+#include "cvtool/core/frame_capture.hpp"
+
+#include <fmt/core.h>
+
+#include <utility>
+
+namespace cvtool::core
+{
+
+FrameCapture::FrameCapture(cv::VideoCapture &cap, std::size_t slots, bool drop_oldest, int max_read_failures)
+    : cap_(cap),
+      drop_oldest_(drop_oldest),
+      max_read_failures_(max_read_failures),
+      slots_(slots > 0 ? slots : 1)
+{
+}
+
+FrameCapture::~FrameCapture()
+{
+    stop();
+}
+
+void FrameCapture::start()
+{
+    if (worker_.joinable())
+        return;
+
+    const int w = static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_WIDTH));
+    const int h = static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_HEIGHT));
+    if (w > 0 && h > 0)
+    {
+        for (auto &slot : slots_)
+            slot.image.create(h, w, CV_8UC3);
+    }
+
+    fps_window_start_ = std::chrono::steady_clock::now();
+    worker_ = std::thread(&FrameCapture::run, this);
+}
+
+void FrameCapture::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    not_full_.notify_all();
+
+    if (worker_.joinable())
+        worker_.join();
+}
+
+void FrameCapture::run()
+{
+    CapturedFrame scratch;
+    if (!slots_.front().image.empty())
+        scratch.image.create(slots_.front().image.size(), slots_.front().image.type());
+
+    int fail_streak{0};
+
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_)
+                break;
+        }
+
+        const bool ok = cap_.read(scratch.image);
+        const auto now = std::chrono::steady_clock::now();
+
+        if (!ok || scratch.image.empty())
+        {
+            // A file that stops delivering frames has simply ended.
+            if (!drop_oldest_)
+                break;
+
+            fail_streak++;
+            fmt::println(stderr, "warning: failed to read frame");
+            if (fail_streak >= max_read_failures_)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                failed_ = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        fail_streak = 0;
+        scratch.captured_at = now;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!drop_oldest_)
+        {
+            not_full_.wait(lock, [&]
+                           { return stop_ || count_ < slots_.size(); });
+            if (stop_)
+                break;
+        }
+
+        stats_.captured++;
+        scratch.seq = stats_.captured;
+
+        fps_window_frames_++;
+        const double window_s = std::chrono::duration<double>(now - fps_window_start_).count();
+        if (window_s >= 1.0)
+        {
+            stats_.fps = fps_window_frames_ / window_s;
+            fps_window_frames_ = 0;
+            fps_window_start_ = now;
+        }
+
+        if (count_ == slots_.size())
+        {
+            head_ = (head_ + 1) % slots_.size();
+            count_--;
+            stats_.dropped++;
+        }
+
+        // The displaced buffer comes back in scratch and is reused by the next read.
+        std::swap(slots_[(head_ + count_) % slots_.size()], scratch);
+        count_++;
+
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ended_ = true;
+    }
+    not_empty_.notify_all();
+}
+
+CaptureStatus FrameCapture::next(CapturedFrame &out, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!not_empty_.wait_for(lock, timeout, [&]
+                             { return count_ > 0 || ended_; }))
+        return CaptureStatus::Timeout;
+
+    if (count_ == 0)
+        return CaptureStatus::End;
+
+    std::swap(out, slots_[head_]);
+    head_ = (head_ + 1) % slots_.size();
+    count_--;
+
+    lock.unlock();
+    not_full_.notify_one();
+    return CaptureStatus::Frame;
+}
+
+bool FrameCapture::failed() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+CaptureStats FrameCapture::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+}
@@ -1,7 +1,10 @@
 #include "cvtool/core/gesture/contextual_gesture_rules.hpp"
 #include "cvtool/core/gesture/gesture_rules.hpp"
 
+#include <opencv2/core/hal/intrin.hpp>
+
 #include <algorithm>
+#include <vector>
 
 namespace cvtool::core::gesture
 {
@@ -79,4 +82,83 @@ GestureID classify_contextual_gesture(
 
 
 
+void classify_contextual_gesture_batch(
+    const HandLandmarkBatch &hands,
+    const FaceLandmarkBatch &faces,
+    GestureID *out_gestures,
+    const std::uint8_t *finger_masks)
+{
+    CV_Assert(faces.size() == hands.size());
+
+    const std::size_t n = hands.size();
+    std::vector<std::uint8_t> local_masks;
+    if (finger_masks == nullptr)
+    {
+        local_masks.resize(n);
+        extract_finger_state_batch(hands, local_masks.data());
+        finger_masks = local_masks.data();
+    }
+
+    std::size_t i = 0;
+
+#if CV_SIMD128
+    const auto load = [&](const std::vector<float> &v) { return cv::v_load(v.data() + i); };
+    const auto dist = [](const cv::v_float32x4 &x1, const cv::v_float32x4 &y1,
+                         const cv::v_float32x4 &x2, const cv::v_float32x4 &y2)
+    {
+        const cv::v_float32x4 dx = x1 - x2;
+        const cv::v_float32x4 dy = y1 - y2;
+        return cv::v_sqrt(dx * dx + dy * dy);
+    };
+    const cv::v_float32x4 zero = cv::v_setall_f32(0.0f);
+    const cv::v_float32x4 eps = cv::v_setall_f32(1e-3f);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        const cv::v_float32x4 tip_x = load(hands.x[IndexTip]);
+        const cv::v_float32x4 tip_y = load(hands.y[IndexTip]);
+        const cv::v_float32x4 mouth_x = load(faces.mouth_x);
+        const cv::v_float32x4 mouth_y = load(faces.mouth_y);
+        const cv::v_float32x4 face_w = load(faces.bbox_w);
+        const cv::v_float32x4 face_h = load(faces.bbox_h);
+        const cv::v_float32x4 face_scale = cv::v_max(face_w, face_h);
+
+        const cv::v_float32x4 palm_scale = dist(
+            load(hands.x[Wrist]), load(hands.y[Wrist]), load(hands.x[MiddleMcp]), load(hands.y[MiddleMcp]));
+        const cv::v_float32x4 index_ratio =
+            dist(tip_x, tip_y, load(hands.x[IndexMcp]), load(hands.y[IndexMcp])) / palm_scale;
+
+        // Early returns of is_monkey_gesture, as rejection bits.
+        const int rejected =
+            cv::v_signmask(load(faces.confidence) < cv::v_setall_f32(0.6f)) |
+            cv::v_signmask(face_w <= zero) |
+            cv::v_signmask(face_h <= zero) |
+            cv::v_signmask(palm_scale <= eps) |
+            cv::v_signmask(face_scale <= eps);
+
+        const int accepted = cv::v_signmask(
+            (index_ratio >= cv::v_setall_f32(0.55f)) &
+            (index_ratio <= cv::v_setall_f32(1.35f)) &
+            (dist(tip_x, tip_y, mouth_x, mouth_y) / face_scale < cv::v_setall_f32(0.20f)) &
+            (cv::v_absdiff(tip_x, mouth_x) / face_w < cv::v_setall_f32(0.22f)) &
+            (cv::v_absdiff(tip_y, mouth_y) / face_h < cv::v_setall_f32(0.22f)));
+
+        for (int lane = 0; lane < 4; lane++)
+        {
+            const std::size_t s = i + lane;
+            const bool monkey =
+                faces.has_face[s] != 0 && hands.has_hand[s] != 0 &&
+                finger_masks[s] == 0 &&
+                ((rejected >> lane) & 1) == 0 &&
+                ((accepted >> lane) & 1) != 0;
+
+            out_gestures[s] = monkey ? GestureID::Monkey : GestureID::Unknown;
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+        out_gestures[i] = classify_contextual_gesture(hands.at(i), faces.at(i));
+}
+
 }
\ No newline at end of file
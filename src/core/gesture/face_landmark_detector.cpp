@@ -1,50 +1,105 @@
 #include "cvtool/core/gesture/face_landmark_detector.hpp"
+#include "cvtool/core/gesture/tensor_prep.hpp"
 
 #include <fmt/format.h>
 
-#include <locale>
-#include <codecvt>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <vector>
 
 namespace cvtool::core::gesture
 {
 
-    cv::Mat FaceLandmarkDetector::preprocess_image(const cv::Mat &frame)
+    void FaceLandmarkDetector::preprocess_image(const cv::Mat &frame, float &scale)
     {
-        cv::Mat resized;
-        cv::resize(frame, resized, cv::Size(input_width_, input_height_));
-        cv::Mat colored;
-        cv::cvtColor(resized, colored, cv::COLOR_BGR2RGB);
-        cv::Mat result = cv::dnn::blobFromImage(
-            colored, 1.0 / 128.0, cv::Size(input_width_, input_height_),
-            cv::Scalar(127.5, 127.5, 127.5), false, false);
+        scale = std::min(static_cast<float>(input_size_) / static_cast<float>(frame.cols),
+                         static_cast<float>(input_size_) / static_cast<float>(frame.rows));
+        const int resized_w = std::clamp(static_cast<int>(std::lround(frame.cols * scale)), 1, input_size_);
+        const int resized_h = std::clamp(static_cast<int>(std::lround(frame.rows * scale)), 1, input_size_);
 
-        return result;
+        // The padding only has to be cleared again when the letterboxed area shrinks.
+        if (canvas_.rows != input_size_ || canvas_.cols != input_size_)
+        {
+            canvas_.create(input_size_, input_size_, CV_8UC3);
+            canvas_.setTo(cv::Scalar(0, 0, 0));
+        }
+        else if (resized_w < canvas_content_.width || resized_h < canvas_content_.height)
+        {
+            canvas_.setTo(cv::Scalar(0, 0, 0));
+        }
+        canvas_content_ = cv::Size(resized_w, resized_h);
+
+        cv::Mat resized = canvas_(cv::Rect(0, 0, resized_w, resized_h));
+        cv::resize(frame, resized, resized.size());
+
+        input_buffer_.resize(static_cast<std::size_t>(3 * input_size_ * input_size_));
+        pack_bgr_to_rgb_planar(canvas_, input_buffer_.data(), 127.5f, 1.0f / 128.0f);
     }
 
-    Ort::Value FaceLandmarkDetector::create_input_tensor(cv::Mat &blob)
+    Ort::Value FaceLandmarkDetector::create_input_tensor()
     {
         auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-        float *data = blob.ptr<float>();
         Ort::Value tensor = Ort::Value::CreateTensor<float>(
-            memory_info, data, blob.total(), input_shape_.data(), input_shape_.size());
+            memory_info, input_buffer_.data(), input_buffer_.size(), input_shape_.data(), input_shape_.size());
 
         return tensor;
     }
 
+    static double elapsed_ms(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+
     cvtool::core::ExitCode FaceLandmarkDetector::initialize(
-        const std::string &model_path, std::string &err)
+        const std::string &model_path, std::string &err, int input_size)
     {
+        load_timings_ = {};
+
+        if (std::find(supported_input_sizes.begin(), supported_input_sizes.end(), input_size) ==
+            supported_input_sizes.end())
+        {
+            err = fmt::format("error: unsupported face input size {} (expected 320, 480 or 640)", input_size);
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+        input_size_ = input_size;
+        input_shape_ = {1, 3, input_size_, input_size_};
+
+        const auto read_start = std::chrono::steady_clock::now();
+        std::vector<char> model_bytes;
+        const auto read_code = read_model_file(model_path, model_bytes, err);
+        if (read_code != cvtool::core::ExitCode::Ok)
+            return read_code;
+        load_timings_.read_ms = elapsed_ms(read_start);
+
         try
         {
             env_ = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_FATAL, "FaceDetectorEnv");
             options_.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
             options_.SetIntraOpNumThreads(2);
 
-            std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-            std::wstring w_path = converter.from_bytes(model_path);
+            const auto session_start = std::chrono::steady_clock::now();
+            session_ = std::make_unique<Ort::Session>(*env_, model_bytes.data(), model_bytes.size(), options_);
+            load_timings_.session_ms = elapsed_ms(session_start);
 
-            session_ = std::make_unique<Ort::Session>(*env_, w_path.c_str(), options_);
+            const auto input_info = session_->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo();
+            if (input_info.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+            {
+                err = fmt::format("error: face model input must be float32: {}\n"
+                                  "quantized models must keep float inputs (QDQ format)",
+                                  model_path);
+                return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+            }
+
+            const auto input_dims = input_info.GetShape();
+            if (input_dims.size() == 4 &&
+                ((input_dims[2] > 0 && input_dims[2] != input_size_) ||
+                 (input_dims[3] > 0 && input_dims[3] != input_size_)))
+            {
+                err = fmt::format("error: face model has a fixed {}x{} input, cannot run it at {}x{}: {}",
+                                  input_dims[3], input_dims[2], input_size_, input_size_, model_path);
+                return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+            }
 
             initialized_ = true;
 
@@ -55,11 +110,6 @@ namespace cvtool::core::gesture
             err = fmt::format("error: ONNX Runtime issue ({})", e.what());
             return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
         }
-        catch (const std::range_error &e)
-        {
-            err = fmt::format("error: Invalid UTF-8 in model_path ({})", e.what());
-            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
-        }
         catch (const std::bad_alloc &e)
         {
             err = fmt::format("{}", e.what());
@@ -73,60 +123,72 @@ namespace cvtool::core::gesture
     }
 
     cvtool::core::gesture::FaceLandmarkResult FaceLandmarkDetector::decode_output(
-        std::vector<Ort::Value> &out_tensor, const cv::Mat &frame, const cv::Rect &roi)
+        std::vector<Ort::Value> &out_tensor, const cv::Mat &frame, const cv::Rect &roi, float scale)
     {
         FaceLandmarkResult result;
-        const float *score_data = out_tensor[2].GetTensorMutableData<float>();
-        auto info = out_tensor[2].GetTensorTypeAndShapeInfo();
-        auto shape = info.GetShape();
-        auto count = info.GetElementCount();
+        if (out_tensor.size() < output_names_.size())
+            return result;
 
+        // Outputs are grouped by kind: scores[8,16,32], bboxes[8,16,32], keypoints[8,16,32].
+        int best_level{-1};
         int best_index{-1};
         float max_score{0.0f};
-        for (int i = 0; i < count; i++)
+        for (std::size_t level = 0; level < strides_.size(); level++)
         {
-            if (score_data[i] > max_score)
+            const int grid = input_size_ / strides_[level];
+            const auto count = out_tensor[level].GetTensorTypeAndShapeInfo().GetElementCount();
+            if (count == 0 || count % static_cast<std::size_t>(grid * grid) != 0)
+                continue;
+
+            const float *score_data = out_tensor[level].GetTensorMutableData<float>();
+            for (std::size_t i = 0; i < count; i++)
             {
-                max_score = score_data[i];
-                best_index = i;
+                if (score_data[i] > max_score)
+                {
+                    max_score = score_data[i];
+                    best_level = static_cast<int>(level);
+                    best_index = static_cast<int>(i);
+                }
             }
         }
+
         if ((max_score > min_face_score_) && (best_index != -1))
         {
-            int cell_index = best_index / 2;
-            int row = cell_index / 20;
-            int col = cell_index % 20;
-            float cc_x = (col * 32.0f) + 16.0f;
-            float cc_y = (row * 32.0f) + 16.0f;
-
-            float scale_x = static_cast<float>(frame.cols) / static_cast<float>(input_width_);
-            float scale_y = static_cast<float>(frame.rows) / static_cast<float>(input_height_);
+            const int stride = strides_[best_level];
+            const int grid = input_size_ / stride;
+            const auto count = out_tensor[best_level].GetTensorTypeAndShapeInfo().GetElementCount();
+            const int anchors = static_cast<int>(count / static_cast<std::size_t>(grid * grid));
 
-            float stride_mult = 32.0f;
+            int cell_index = best_index / anchors;
+            int row = cell_index / grid;
+            int col = cell_index % grid;
+            const float stride_mult = static_cast<float>(stride);
+            float cc_x = (col * stride_mult) + (stride_mult / 2.0f);
+            float cc_y = (row * stride_mult) + (stride_mult / 2.0f);
 
-            const float *bbox_data = out_tensor[5].GetTensorMutableData<float>();
-            float bbox_x_min = cc_x - (bbox_data[best_index * 4 + 0] * stride_mult);
-            float bbox_y_min = cc_y - (bbox_data[best_index * 4 + 1] * stride_mult);
-            float bbox_x_max = cc_x + (bbox_data[best_index * 4 + 2] * stride_mult);
-            float bbox_y_max = cc_y + (bbox_data[best_index * 4 + 3] * stride_mult);
+            const auto to_frame_x = [&](float x)
+            { return std::clamp(x / scale, 0.0f, static_cast<float>(frame.cols)) + roi.x; };
+            const auto to_frame_y = [&](float y)
+            { return std::clamp(y / scale, 0.0f, static_cast<float>(frame.rows)) + roi.y; };
 
-            result.bbox.x = (bbox_x_min * scale_x) + roi.x;
-            result.bbox.y = (bbox_y_min * scale_y) + roi.y;
-            result.bbox.width = (bbox_x_max - bbox_x_min) * scale_x;
-            result.bbox.height = (bbox_y_max - bbox_y_min) * scale_y;
+            const float *bbox_data = out_tensor[best_level + 3].GetTensorMutableData<float>();
+            float bbox_x_min = to_frame_x(cc_x - (bbox_data[best_index * 4 + 0] * stride_mult));
+            float bbox_y_min = to_frame_y(cc_y - (bbox_data[best_index * 4 + 1] * stride_mult));
+            float bbox_x_max = to_frame_x(cc_x + (bbox_data[best_index * 4 + 2] * stride_mult));
+            float bbox_y_max = to_frame_y(cc_y + (bbox_data[best_index * 4 + 3] * stride_mult));
 
-            const float *kps_data = out_tensor[8].GetTensorMutableData<float>();
-            float mouth_x_min = cc_x + (kps_data[best_index * 10 + 6] * stride_mult);
-            float mouth_y_min = cc_y + (kps_data[best_index * 10 + 7] * stride_mult);
-            float mouth_x_max = cc_x + (kps_data[best_index * 10 + 8] * stride_mult);
-            float mouth_y_max = cc_y + (kps_data[best_index * 10 + 9] * stride_mult);
+            result.bbox.x = static_cast<int>(bbox_x_min);
+            result.bbox.y = static_cast<int>(bbox_y_min);
+            result.bbox.width = static_cast<int>(bbox_x_max - bbox_x_min);
+            result.bbox.height = static_cast<int>(bbox_y_max - bbox_y_min);
 
-            float mouth_cx = (mouth_x_min + mouth_x_max) / 2.0;
-            float mouth_cy = (mouth_y_min + mouth_y_max) / 2.0;
-
-            result.mouth_center.x = mouth_cx * scale_x + roi.x;
-            result.mouth_center.y = mouth_cy * scale_y + roi.y;
+            const float *kps_data = out_tensor[best_level + 6].GetTensorMutableData<float>();
+            result.mouth_left.x = to_frame_x(cc_x + (kps_data[best_index * 10 + 6] * stride_mult));
+            result.mouth_left.y = to_frame_y(cc_y + (kps_data[best_index * 10 + 7] * stride_mult));
+            result.mouth_right.x = to_frame_x(cc_x + (kps_data[best_index * 10 + 8] * stride_mult));
+            result.mouth_right.y = to_frame_y(cc_y + (kps_data[best_index * 10 + 9] * stride_mult));
 
+            result.mouth_center = (result.mouth_left + result.mouth_right) * 0.5f;
 
             result.confidence = max_score;
             result.has_face = true;
@@ -135,6 +197,15 @@ namespace cvtool::core::gesture
         return result;
     }
 
+    cv::Mat FaceLandmarkDetector::input_blob(const cv::Mat &frame, const cv::Rect &roi)
+    {
+        float scale{1.0f};
+        preprocess_image(roi.empty() ? frame : frame(roi), scale);
+
+        const int sizes[4] = {1, 3, input_size_, input_size_};
+        return cv::Mat(4, sizes, CV_32F, input_buffer_.data()).clone();
+    }
+
     FaceLandmarkResult FaceLandmarkDetector::detect(
         const cv::Mat &frame, const cv::Rect &roi)
     {
@@ -144,9 +215,12 @@ namespace cvtool::core::gesture
             return result;
 
         cv::Mat new_frame = roi.empty() ? frame : frame(roi);
+        if (new_frame.empty())
+            return result;
 
-        cv::Mat blob = preprocess_image(new_frame);
-        Ort::Value input_tensor = create_input_tensor(blob);
+        float scale{1.0f};
+        preprocess_image(new_frame, scale);
+        Ort::Value input_tensor = create_input_tensor();
         std::vector<Ort::Value> output_tensors = session_->Run(
             Ort::RunOptions{nullptr},
             input_names_.data(),
@@ -154,7 +228,40 @@ namespace cvtool::core::gesture
             output_names_.data(),
             output_names_.size());
 
-        return decode_output(output_tensors, new_frame, roi);
+        return decode_output(output_tensors, new_frame, roi, scale);
+    }
+
+    cvtool::core::ExitCode FaceLandmarkDetector::warm_up(int runs, std::string &err)
+    {
+        if (!initialized_)
+        {
+            err = "error: face detector warm-up: detector is not initialized";
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+
+        const auto warmup_start = std::chrono::steady_clock::now();
+        try
+        {
+            for (int r = 0; r < runs; r++)
+            {
+                input_buffer_.assign(static_cast<std::size_t>(3 * input_size_ * input_size_), 0.0f);
+                Ort::Value input_tensor = create_input_tensor();
+                session_->Run(
+                    Ort::RunOptions{nullptr},
+                    input_names_.data(),
+                    &input_tensor, 1,
+                    output_names_.data(),
+                    output_names_.size());
+            }
+        }
+        catch (const Ort::Exception &e)
+        {
+            err = fmt::format("error: face detector warm-up: ONNX Runtime issue ({})", e.what());
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+
+        load_timings_.warmup_ms = elapsed_ms(warmup_start);
+        return cvtool::core::ExitCode::Ok;
     }
 
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "cvtool/core/gesture/gesture_bank.hpp"
+#include "cvtool/core/gesture/display_utils.hpp"
+#include "cvtool/core/image_io.hpp"
 
 #include <nlohmann/json.hpp>
 #include <opencv2/opencv.hpp>
@@ -6,39 +8,102 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
-#include <unordered_set>
+#include <algorithm>
+#include <atomic>
 #include <string_view>
 #include <fstream>
+#include <thread>
 
 namespace cvtool::core::gesture
 {
 
 
-const cv::Mat &get_gesture_image(const GestureImageBank &bank, cvtool::core::gesture::GestureID id)
+static std::size_t image_bytes(const cv::Mat &img)
+{
+    return img.total() * img.elemSize();
+}
+
+static cv::Mat decode_gesture_image(const std::filesystem::path &image_path, const cv::Size &display_size)
+{
+    // The image is letterboxed to display_size, so large JPEGs can be decoded at reduced scale.
+    cv::Mat img;
+    std::string err;
+    if (cvtool::core::image_io::read_image(image_path.string(), img, err, display_size) != cvtool::core::ExitCode::Ok)
+        return {};
+
+    cv::Mat bgr_img;
+    if (img.channels() == 1){
+        cv::cvtColor(img, bgr_img, cv::COLOR_GRAY2BGR);
+    } else if (img.channels() == 4){
+        cv::cvtColor(img, bgr_img, cv::COLOR_BGRA2BGR);
+    } else {
+        bgr_img = img;
+    }
+
+    if (display_size.empty())
+        return bgr_img;
+
+    return letterbox(bgr_img, display_size.width, display_size.height);
+}
+
+const cv::Mat &get_gesture_image(GestureImageBank &bank, cvtool::core::gesture::GestureID id)
 {
     std::string_view gest_name = to_asset_key(id);
 
     auto it = bank.images.find(gest_name);
     if (it != bank.images.end() && !it->second.empty()){
+        if (bank.max_bytes > 0)
+        {
+            auto pos = std::find(bank.lru.begin(), bank.lru.end(), gest_name);
+            if (pos != bank.lru.end())
+                bank.lru.splice(bank.lru.begin(), bank.lru, pos);
+        }
         return it->second;
     } 
-    
-    return bank.fallback;
+
+    auto path_it = bank.paths.find(gest_name);
+    if (bank.max_bytes == 0 || path_it == bank.paths.end())
+        return bank.fallback;
+
+    cv::Mat img = decode_gesture_image(path_it->second, bank.display_size);
+    if (img.empty())
+    {
+        bank.paths.erase(path_it);
+        return bank.fallback;
+    }
+
+    while (!bank.lru.empty() && bank.cached_bytes + image_bytes(img) > bank.max_bytes)
+    {
+        auto victim = bank.images.find(bank.lru.back());
+        if (victim != bank.images.end())
+        {
+            bank.cached_bytes -= image_bytes(victim->second);
+            bank.images.erase(victim);
+        }
+        bank.lru.pop_back();
+    }
+
+    bank.cached_bytes += image_bytes(img);
+    bank.lru.emplace_front(gest_name);
+    return bank.images[std::string(gest_name)] = img;
 }
 
 cvtool::core::ExitCode load_gesture_image_bank(
     const std::string &map_path,
     GestureImageBank &out_bank,
     std::vector<std::string> &warnings,
-    std::string &err
+    std::string &err,
+    const GestureBankOptions &options
 )
 {
     warnings.clear();
     out_bank.fallback.release();
     out_bank.images.clear();
-
-    const std::unordered_set<std::string> whitelist{
-        "open_palm", "fist", "peace", "thumbs_up", "monkey", "none", "unknown"};
+    out_bank.paths.clear();
+    out_bank.lru.clear();
+    out_bank.cached_bytes = 0;
+    out_bank.display_size = options.display_size;
+    out_bank.max_bytes = options.max_bytes;
 
     std::ifstream file(map_path);
     if (!file)
@@ -67,6 +132,14 @@ cvtool::core::ExitCode load_gesture_image_bank(
     std::filesystem::path mp(map_path);
     out_bank.base_dir = mp.parent_path();
 
+    struct DecodeJob
+    {
+        std::string gesture;
+        std::filesystem::path path;
+        cv::Mat image;
+    };
+    std::vector<DecodeJob> jobs;
+
     for (auto &[gesture, path] : j.items())
     {
         if (!path.is_string())
@@ -76,7 +149,8 @@ cvtool::core::ExitCode load_gesture_image_bank(
                 gesture, path.dump()));
             continue;
         }
-        if (!whitelist.contains(gesture))
+        GestureID known_id{GestureID::Unknown};
+        if (!find_gesture(gesture, known_id))
         {
             warnings.push_back(fmt::format(
                 "[gesture_bank] warn: unknown gesture ignored; gest={}; path={}", 
@@ -110,28 +184,45 @@ cvtool::core::ExitCode load_gesture_image_bank(
             continue;
         }
 
-        cv::Mat img = cv::imread(image_path.string(), cv::IMREAD_UNCHANGED);
-        if (img.empty())
+        // "none" is the fallback and is always decoded up front, even in lazy mode.
+        if (out_bank.max_bytes > 0 && gesture != "none")
+            out_bank.paths[gesture] = image_path;
+        else
+            jobs.push_back({gesture, image_path, {}});
+    }
+
+    unsigned thread_count = options.threads > 0 ? options.threads : std::thread::hardware_concurrency();
+    thread_count = std::clamp(thread_count, 1u, static_cast<unsigned>(std::max<std::size_t>(jobs.size(), 1)));
+
+    std::atomic<std::size_t> next_job{0};
+    const auto decode_worker = [&]()
+    {
+        for (std::size_t i = next_job++; i < jobs.size(); i = next_job++)
+            jobs[i].image = decode_gesture_image(jobs[i].path, out_bank.display_size);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(thread_count - 1);
+    for (unsigned t = 1; t < thread_count; t++)
+        workers.emplace_back(decode_worker);
+    decode_worker();
+    for (auto &w : workers)
+        w.join();
+
+    for (auto &job : jobs)
+    {
+        if (job.image.empty())
         {
             warnings.push_back(fmt::format(
                 "[gesture_bank] warn: cannot read image; gest={}; path={}", 
-                gesture, image_path.string()));
+                job.gesture, job.path.string()));
             continue;
         }
 
-        cv::Mat bgr_img;
-        if (img.channels() == 1){
-            cv::cvtColor(img, bgr_img, cv::COLOR_GRAY2BGR);
-        } else if (img.channels() == 4){
-            cv::cvtColor(img, bgr_img, cv::COLOR_BGRA2BGR);
-        } else {
-            bgr_img = img;
-        }
-
-        if (gesture == "none")
-            out_bank.fallback = bgr_img;
+        if (job.gesture == "none")
+            out_bank.fallback = job.image;
         else
-            out_bank.images[gesture] = bgr_img;
+            out_bank.images[job.gesture] = job.image;
     }
 
     if (out_bank.fallback.empty())
@@ -139,7 +230,7 @@ cvtool::core::ExitCode load_gesture_image_bank(
         warnings.push_back(fmt::format(
             "[gesture_bank] warn: no 'none' image configured, will use default fallback"));
     }
-    if (out_bank.fallback.empty())
+    if (out_bank.fallback.empty() && out_bank.images.empty() && out_bank.paths.empty())
     {
         warnings.push_back(fmt::format(
             "[gesture_bank] warn: no gesture images loaded at all"));
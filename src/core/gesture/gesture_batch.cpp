@@ -0,0 +1,91 @@
+#include "cvtool/core/gesture/gesture_batch.hpp"
+
+namespace cvtool::core::gesture
+{
+
+void HandLandmarkBatch::reserve(std::size_t n)
+{
+    for (std::size_t k = 0; k < x.size(); k++)
+    {
+        x[k].reserve(n);
+        y[k].reserve(n);
+    }
+    confidence.reserve(n);
+    has_hand.reserve(n);
+}
+
+void HandLandmarkBatch::clear()
+{
+    for (std::size_t k = 0; k < x.size(); k++)
+    {
+        x[k].clear();
+        y[k].clear();
+    }
+    confidence.clear();
+    has_hand.clear();
+}
+
+void HandLandmarkBatch::push_back(const HandLandmarkResult &hand)
+{
+    for (std::size_t k = 0; k < x.size(); k++)
+    {
+        x[k].push_back(hand.points[k].x);
+        y[k].push_back(hand.points[k].y);
+    }
+    confidence.push_back(hand.confidence);
+    has_hand.push_back(hand.has_hand ? 1 : 0);
+}
+
+HandLandmarkResult HandLandmarkBatch::at(std::size_t i) const
+{
+    HandLandmarkResult hand;
+    hand.has_hand = has_hand[i] != 0;
+    hand.confidence = confidence[i];
+    for (std::size_t k = 0; k < x.size(); k++)
+        hand.points[k] = cv::Point2f(x[k][i], y[k][i]);
+
+    return hand;
+}
+
+void FaceLandmarkBatch::reserve(std::size_t n)
+{
+    has_face.reserve(n);
+    confidence.reserve(n);
+    bbox_w.reserve(n);
+    bbox_h.reserve(n);
+    mouth_x.reserve(n);
+    mouth_y.reserve(n);
+}
+
+void FaceLandmarkBatch::clear()
+{
+    has_face.clear();
+    confidence.clear();
+    bbox_w.clear();
+    bbox_h.clear();
+    mouth_x.clear();
+    mouth_y.clear();
+}
+
+void FaceLandmarkBatch::push_back(const FaceLandmarkResult &face)
+{
+    has_face.push_back(face.has_face ? 1 : 0);
+    confidence.push_back(face.confidence);
+    bbox_w.push_back(static_cast<float>(face.bbox.width));
+    bbox_h.push_back(static_cast<float>(face.bbox.height));
+    mouth_x.push_back(face.mouth_center.x);
+    mouth_y.push_back(face.mouth_center.y);
+}
+
+FaceLandmarkResult FaceLandmarkBatch::at(std::size_t i) const
+{
+    FaceLandmarkResult face;
+    face.has_face = has_face[i] != 0;
+    face.confidence = confidence[i];
+    face.bbox = cv::Rect(0, 0, static_cast<int>(bbox_w[i]), static_cast<int>(bbox_h[i]));
+    face.mouth_center = cv::Point2f(mouth_x[i], mouth_y[i]);
+
+    return face;
+}
+
+}
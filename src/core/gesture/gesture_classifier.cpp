@@ -0,0 +1,34 @@
+#include "cvtool/core/gesture/gesture_classifier.hpp"
+#include "cvtool/core/gesture/contextual_gesture_rules.hpp"
+
+namespace cvtool::core::gesture
+{
+
+ClassifierResult classify_gesture(
+    const HandLandmarkResult &hand,
+    const FaceLandmarkResult &face,
+    bool contextual,
+    const GestureRuleTable *rules)
+{
+    if (rules != nullptr)
+        return classify_with_rules(*rules, hand, face, contextual);
+
+    ClassifierResult raw_gesture = classify_hand_gesture(hand);
+
+    if (contextual)
+    {
+        auto ctx_gesture = classify_contextual_gesture(hand, face);
+
+        if (ctx_gesture != GestureID::None &&
+            ctx_gesture != GestureID::Unknown &&
+            (raw_gesture.gesture == GestureID::Unknown ||
+             raw_gesture.gesture == GestureID::Fist))
+        {
+            raw_gesture.gesture = ctx_gesture;
+        }
+    }
+
+    return raw_gesture;
+}
+
+}
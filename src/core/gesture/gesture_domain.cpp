@@ -1,8 +1,37 @@
 #include "cvtool/core/gesture/gesture_domain.hpp"
 
+#include <fmt/format.h>
+
+#include <array>
+#include <deque>
+#include <string>
+
 namespace cvtool::core::gesture
 {
 
+struct RegisteredGesture
+{
+    std::string asset_key;
+    std::string debug_label;
+};
+
+// deque: string_views handed out by to_asset_key/to_debug_label stay valid on growth
+static std::deque<RegisteredGesture> &registered_gestures()
+{
+    static std::deque<RegisteredGesture> gestures;
+    return gestures;
+}
+
+static const RegisteredGesture *find_registered(GestureID id)
+{
+    const int index = static_cast<int>(id) - static_cast<int>(GestureID::Unknown) - 1;
+    const auto &gestures = registered_gestures();
+    if (index < 0 || index >= static_cast<int>(gestures.size()))
+        return nullptr;
+
+    return &gestures[static_cast<std::size_t>(index)];
+}
+
 std::string_view to_asset_key(GestureID id)
 {
     switch (id)
@@ -19,7 +48,11 @@ std::string_view to_asset_key(GestureID id)
         return "thumbs_up";
     case GestureID::Monkey:
         return "monkey";
+    case GestureID::Unknown:
+        return "unknown";
     default:
+        if (const auto *registered = find_registered(id))
+            return registered->asset_key;
         return "unknown";
     }
 }
@@ -40,9 +73,55 @@ std::string_view to_debug_label(GestureID id)
         return "Thumbs Up (Detected)";
     case GestureID::Monkey:
         return "Monkey (Detected)";
+    case GestureID::Unknown:
+        return "Unknown Gesture - Fallback";
     default:
+        if (const auto *registered = find_registered(id))
+            return registered->debug_label;
         return "Unknown Gesture - Fallback";
     }
 }
 
+bool find_gesture(std::string_view asset_key, GestureID &out_id)
+{
+    constexpr std::array<GestureID, 7> builtin{
+        GestureID::None, GestureID::OpenPalm, GestureID::Fist, GestureID::Peace,
+        GestureID::ThumbsUp, GestureID::Monkey, GestureID::Unknown};
+
+    for (const auto id : builtin)
+    {
+        if (to_asset_key(id) == asset_key)
+        {
+            out_id = id;
+            return true;
+        }
+    }
+
+    const auto &gestures = registered_gestures();
+    for (std::size_t i = 0; i < gestures.size(); i++)
+    {
+        if (gestures[i].asset_key == asset_key)
+        {
+            out_id = static_cast<GestureID>(static_cast<int>(GestureID::Unknown) + 1 + static_cast<int>(i));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+GestureID register_gesture(std::string_view asset_key, std::string_view debug_label)
+{
+    GestureID id{GestureID::Unknown};
+    if (find_gesture(asset_key, id))
+        return id;
+
+    auto &gestures = registered_gestures();
+    gestures.push_back({
+        std::string(asset_key),
+        debug_label.empty() ? fmt::format("{} (Detected)", asset_key) : std::string(debug_label)});
+
+    return static_cast<GestureID>(static_cast<int>(GestureID::Unknown) + static_cast<int>(gestures.size()));
+}
+
 }
\ No newline at end of file
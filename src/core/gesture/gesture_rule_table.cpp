@@ -0,0 +1,334 @@
+#include "cvtool/core/gesture/gesture_rule_table.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string_view>
+
+namespace cvtool::core::gesture
+{
+
+constexpr std::array<std::string_view, 21> landmark_names{
+    "wrist",
+    "thumb_cmc", "thumb_mcp", "thumb_ip", "thumb_tip",
+    "index_mcp", "index_pip", "index_dip", "index_tip",
+    "middle_mcp", "middle_pip", "middle_dip", "middle_tip",
+    "ring_mcp", "ring_pip", "ring_dip", "ring_tip",
+    "pinky_mcp", "pinky_pip", "pinky_dip", "pinky_tip"};
+
+constexpr std::array<std::string_view, 5> finger_names{"thumb", "index", "middle", "ring", "pinky"};
+
+static bool parse_landmark(const nlohmann::json &j, std::uint8_t &out)
+{
+    if (!j.is_string())
+        return false;
+
+    const auto name = j.get<std::string>();
+    const auto it = std::find(landmark_names.begin(), landmark_names.end(), name);
+    if (it == landmark_names.end())
+        return false;
+
+    out = static_cast<std::uint8_t>(it - landmark_names.begin());
+    return true;
+}
+
+static bool parse_landmark_pair(const nlohmann::json &j, std::uint8_t &a, std::uint8_t &b)
+{
+    return j.is_array() && j.size() == 2 && parse_landmark(j[0], a) && parse_landmark(j[1], b);
+}
+
+static bool parse_threshold(const nlohmann::json &p, const char *key, float &out)
+{
+    if (!p.contains(key))
+        return false;
+    if (!p[key].is_number())
+        return false;
+
+    out = p[key].get<float>();
+    return true;
+}
+
+static cvtool::core::ExitCode compile_predicate(
+    const nlohmann::json &p, CompiledRule &rule, std::string &err)
+{
+    if (!p.is_object())
+    {
+        err = "predicate must be an object";
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    RuleInstr instr;
+    float lt{0.0f};
+    float gt{0.0f};
+
+    if (p.contains("above") || p.contains("below"))
+    {
+        const bool above = p.contains("above");
+        if (!parse_landmark_pair(p[above ? "above" : "below"], instr.a, instr.b))
+        {
+            err = fmt::format("'{}' expects two landmark names", above ? "above" : "below");
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+        instr.op = above ? RuleOp::AboveY : RuleOp::BelowY;
+        rule.code.push_back(instr);
+        return cvtool::core::ExitCode::Ok;
+    }
+
+    if (p.contains("dist"))
+    {
+        if (!parse_landmark_pair(p["dist"], instr.a, instr.b))
+        {
+            err = "'dist' expects two landmark names";
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+
+        const bool has_lt = parse_threshold(p, "lt", lt);
+        const bool has_gt = parse_threshold(p, "gt", gt);
+        if (!has_lt && !has_gt)
+        {
+            err = "'dist' needs a numeric 'lt' and/or 'gt' (in palm lengths)";
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+        if (has_gt)
+        {
+            instr.op = RuleOp::DistGt;
+            instr.value = gt;
+            rule.code.push_back(instr);
+        }
+        if (has_lt)
+        {
+            instr.op = RuleOp::DistLt;
+            instr.value = lt;
+            rule.code.push_back(instr);
+        }
+        return cvtool::core::ExitCode::Ok;
+    }
+
+    if (p.contains("face_conf"))
+    {
+        if (!p["face_conf"].is_number())
+        {
+            err = "'face_conf' expects a number";
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+        instr.op = RuleOp::FaceConfGe;
+        instr.value = p["face_conf"].get<float>();
+        rule.code.push_back(instr);
+        rule.needs_face = true;
+        return cvtool::core::ExitCode::Ok;
+    }
+
+    constexpr std::array<std::pair<const char *, RuleOp>, 3> mouth_ops{{
+        {"mouth_dist", RuleOp::MouthDistLt},
+        {"mouth_dx", RuleOp::MouthDxLt},
+        {"mouth_dy", RuleOp::MouthDyLt}}};
+
+    for (const auto &[key, op] : mouth_ops)
+    {
+        if (!p.contains(key))
+            continue;
+
+        if (!parse_landmark(p[key], instr.a))
+        {
+            err = fmt::format("'{}' expects a landmark name", key);
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+        if (!parse_threshold(p, "lt", lt))
+        {
+            err = fmt::format("'{}' needs a numeric 'lt' (in face sizes)", key);
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+        instr.op = op;
+        instr.value = lt;
+        rule.code.push_back(instr);
+        rule.needs_face = true;
+        return cvtool::core::ExitCode::Ok;
+    }
+
+    err = fmt::format("unknown predicate: {}", p.dump());
+    return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+}
+
+cvtool::core::ExitCode load_gesture_rules(
+    const std::string &rules_path, GestureRuleTable &out_table, std::string &err)
+{
+    out_table = GestureRuleTable{};
+
+    std::ifstream file(rules_path);
+    if (!file)
+    {
+        err = fmt::format("error: cannot open the rules file: {}", rules_path);
+        return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
+    }
+
+    nlohmann::json j;
+    try
+    {
+        j = nlohmann::json::parse(file);
+    }
+    catch (const std::exception &e)
+    {
+        err = fmt::format("error: rules file is not valid JSON ({})", e.what());
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    if (!j.is_object() || !j.contains("gestures") || !j["gestures"].is_array())
+    {
+        err = "error: rules file must be an object with a \"gestures\" array";
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    if (j["gestures"].size() > std::numeric_limits<std::uint16_t>::max())
+    {
+        err = "error: rules file has too many gestures";
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    std::size_t index{0};
+    for (const auto &g : j["gestures"])
+    {
+        const auto fail = [&](const std::string &what)
+        {
+            err = fmt::format("error: rules file: gesture #{}: {}", index, what);
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        };
+
+        if (!g.is_object() || !g.contains("id") || !g["id"].is_string())
+            return fail("needs a string \"id\"");
+
+        const auto key = g["id"].get<std::string>();
+        if (key.empty() || key == "none" || key == "unknown")
+            return fail(fmt::format("\"{}\" cannot be used as a gesture id", key));
+
+        const std::string label = (g.contains("label") && g["label"].is_string()) ? g["label"].get<std::string>() : "";
+
+        std::uint8_t care{0};
+        std::uint8_t value{0};
+        if (g.contains("fingers"))
+        {
+            if (!g["fingers"].is_object())
+                return fail("\"fingers\" must be an object");
+
+            for (const auto &[finger, extended] : g["fingers"].items())
+            {
+                const auto it = std::find(finger_names.begin(), finger_names.end(), finger);
+                if (it == finger_names.end() || !extended.is_boolean())
+                    return fail(fmt::format("bad finger entry \"{}\" (thumb|index|middle|ring|pinky: true|false)", finger));
+
+                const auto bit = static_cast<std::uint8_t>(1u << (it - finger_names.begin()));
+                care |= bit;
+                if (extended.get<bool>())
+                    value |= bit;
+            }
+        }
+
+        CompiledRule rule;
+        rule.id = register_gesture(key, label);
+
+        if (g.contains("where"))
+        {
+            if (!g["where"].is_array())
+                return fail("\"where\" must be an array");
+
+            for (const auto &p : g["where"])
+            {
+                std::string what;
+                if (compile_predicate(p, rule, what) != cvtool::core::ExitCode::Ok)
+                    return fail(what);
+            }
+        }
+
+        const auto rule_index = static_cast<std::uint16_t>(out_table.rules.size());
+        out_table.rules.push_back(std::move(rule));
+        for (std::uint8_t mask = 0; mask < 32; mask++)
+        {
+            if ((mask & care) == value)
+                out_table.lut[mask].push_back(rule_index);
+        }
+
+        index++;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+static bool run_rule(
+    const CompiledRule &rule, const HandLandmarkResult &hand, const FaceLandmarkResult &face, float palm_scale)
+{
+    const float face_w = static_cast<float>(face.bbox.width);
+    const float face_h = static_cast<float>(face.bbox.height);
+    const float face_scale = std::max(face_w, face_h);
+
+    for (const auto &instr : rule.code)
+    {
+        const cv::Point2f &a = hand.points[instr.a];
+        const cv::Point2f &b = hand.points[instr.b];
+
+        bool ok{false};
+        switch (instr.op)
+        {
+        case RuleOp::AboveY:
+            ok = a.y < b.y;
+            break;
+        case RuleOp::BelowY:
+            ok = a.y > b.y;
+            break;
+        case RuleOp::DistLt:
+            ok = distance(a, b) / palm_scale < instr.value;
+            break;
+        case RuleOp::DistGt:
+            ok = distance(a, b) / palm_scale > instr.value;
+            break;
+        case RuleOp::FaceConfGe:
+            ok = face.confidence >= instr.value;
+            break;
+        case RuleOp::MouthDistLt:
+            ok = face_scale > 1e-3f && distance(a, face.mouth_center) / face_scale < instr.value;
+            break;
+        case RuleOp::MouthDxLt:
+            ok = face_w > 0.0f && std::abs(a.x - face.mouth_center.x) / face_w < instr.value;
+            break;
+        case RuleOp::MouthDyLt:
+            ok = face_h > 0.0f && std::abs(a.y - face.mouth_center.y) / face_h < instr.value;
+            break;
+        }
+
+        if (!ok)
+            return false;
+    }
+
+    return true;
+}
+
+ClassifierResult classify_with_rules(
+    const GestureRuleTable &table,
+    const HandLandmarkResult &hand,
+    const FaceLandmarkResult &face,
+    bool use_face)
+{
+    const FingerState state = extract_finger_state(hand);
+
+    const float palm_scale = compute_palm_scale(hand);
+    if (palm_scale <= 1e-3f)
+        return {GestureID::Unknown, state};
+
+    const bool face_ok = use_face && face.has_face;
+    for (const auto rule_index : table.lut[finger_mask(state)])
+    {
+        const CompiledRule &rule = table.rules[rule_index];
+        if (rule.needs_face && !face_ok)
+            continue;
+
+        if (run_rule(rule, hand, face, palm_scale))
+            return {rule.id, state};
+    }
+
+    return {GestureID::Unknown, state};
+}
+
+}
@@ -1,7 +1,9 @@
 #include "cvtool/core/gesture/gesture_rules.hpp"
 
 #include <opencv2/opencv.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 
+#include <array>
 #include <cmath>
 
 namespace cvtool::core::gesture
@@ -95,51 +97,170 @@ bool can_classify_hand(
     return true;
 }
 
+std::uint8_t finger_mask(const FingerState &state)
+{
+    return static_cast<std::uint8_t>(
+        (state.thumb_extended ? ThumbBit : 0u) |
+        (state.index_extended ? IndexBit : 0u) |
+        (state.middle_extended ? MiddleBit : 0u) |
+        (state.ring_extended ? RingBit : 0u) |
+        (state.pinky_extended ? PinkyBit : 0u));
+}
+
+struct BuiltinRule
+{
+    std::uint8_t mask;
+    GestureID gesture;
+    bool needs_thumb_up;
+};
+
+constexpr std::array<BuiltinRule, 4> builtin_rules{{
+    {ThumbBit | IndexBit | MiddleBit | RingBit | PinkyBit, GestureID::OpenPalm, false},
+    {0, GestureID::Fist, false},
+    {IndexBit | MiddleBit, GestureID::Peace, false},
+    {ThumbBit, GestureID::ThumbsUp, true}}};
+
+GestureID builtin_gesture(std::uint8_t finger_mask, bool thumb_up)
+{
+    for (const auto &rule : builtin_rules)
+    {
+        if (rule.mask == finger_mask && (!rule.needs_thumb_up || thumb_up))
+            return rule.gesture;
+    }
+
+    return GestureID::Unknown;
+}
+
 cvtool::core::gesture::ClassifierResult classify_hand_gesture(
     const cvtool::core::gesture::HandLandmarkResult &data)
 {
-    FingerState state = extract_finger_state(data);
+    const FingerState state = extract_finger_state(data);
+    const bool thumb_up = is_thumb_pointing_up(data.points[ThumbMcp], data.points[ThumbIp], data.points[ThumbTip]);
+
+    return {builtin_gesture(finger_mask(state), thumb_up), state};
+}
+
+#if CV_SIMD128
+static cv::v_float32x4 v_distance(
+    const cv::v_float32x4 &x1, const cv::v_float32x4 &y1,
+    const cv::v_float32x4 &x2, const cv::v_float32x4 &y2)
+{
+    const cv::v_float32x4 dx = x1 - x2;
+    const cv::v_float32x4 dy = y1 - y2;
+    return cv::v_sqrt(dx * dx + dy * dy);
+}
+
+// Finger masks and thumb-up flags of samples i .. i + 3, same comparisons as the scalar rules.
+static void finger_bits_x4(
+    const HandLandmarkBatch &hands, std::size_t i, std::uint8_t bits[4], bool thumb_up[4])
+{
+    const auto x = [&](int k) { return cv::v_load(hands.x[k].data() + i); };
+    const auto y = [&](int k) { return cv::v_load(hands.y[k].data() + i); };
+
+    const cv::v_float32x4 palm_scale = v_distance(x(Wrist), y(Wrist), x(MiddleMcp), y(MiddleMcp));
 
-    if (state.index_extended == true &&
-        state.middle_extended == true &&
-        state.ring_extended == true &&
-        state.pinky_extended == true &&
-        state.thumb_extended == true)
+    const cv::v_float32x4 thumb =
+        (v_distance(x(ThumbMcp), y(ThumbMcp), x(ThumbTip), y(ThumbTip)) / palm_scale >
+         cv::v_setall_f32(min_thumb_extension_ratio)) &
+        (v_distance(x(ThumbTip), y(ThumbTip), x(IndexMcp), y(IndexMcp)) / palm_scale >
+         cv::v_setall_f32(min_thumb_separation_ratio));
+
+    const auto non_thumb = [&](int mcp, int pip, int dip, int tip)
     {
-        return {GestureID::OpenPalm, state};
+        return (y(tip) < y(dip)) & (y(dip) < y(pip)) & (y(pip) < y(mcp)) &
+               (v_distance(x(tip), y(tip), x(mcp), y(mcp)) / palm_scale >
+                cv::v_setall_f32(min_finger_extension_ratio));
+    };
+
+    // Thumb .. pinky, so finger f lands on bit 1 << f as in FingerBit.
+    const std::array<int, 5> masks{
+        cv::v_signmask(thumb),
+        cv::v_signmask(non_thumb(IndexMcp, IndexPip, IndexDip, IndexTip)),
+        cv::v_signmask(non_thumb(MiddleMcp, MiddlePip, MiddleDip, MiddleTip)),
+        cv::v_signmask(non_thumb(RingMcp, RingPip, RingDip, RingTip)),
+        cv::v_signmask(non_thumb(PinkyMcp, PinkyPip, PinkyDip, PinkyTip))};
+    const int up = cv::v_signmask((y(ThumbTip) < y(ThumbIp)) & (y(ThumbIp) < y(ThumbMcp)));
+
+    for (int lane = 0; lane < 4; lane++)
+    {
+        std::uint8_t b{0};
+        for (int f = 0; f < 5; f++)
+            b |= static_cast<std::uint8_t>(((masks[f] >> lane) & 1) << f);
+        bits[lane] = b;
+        thumb_up[lane] = ((up >> lane) & 1) != 0;
     }
+}
+#endif
 
-    if (state.index_extended == false &&
-        state.middle_extended == false &&
-        state.ring_extended == false &&
-        state.pinky_extended == false &&
-        state.thumb_extended == false)
+static void classify_batch(const HandLandmarkBatch &hands, GestureID *out_gestures, std::uint8_t *out_masks)
+{
+    const std::size_t n = hands.size();
+    std::size_t i = 0;
+
+#if CV_SIMD128
+    for (; i + 4 <= n; i += 4)
     {
-        return {GestureID::Fist, state};
+        std::uint8_t bits[4];
+        bool thumb_up[4];
+        finger_bits_x4(hands, i, bits, thumb_up);
+
+        for (int lane = 0; lane < 4; lane++)
+        {
+            if (out_masks != nullptr)
+                out_masks[i + lane] = bits[lane];
+            if (out_gestures != nullptr)
+                out_gestures[i + lane] = builtin_gesture(bits[lane], thumb_up[lane]);
+        }
     }
+#endif
 
-    if (state.index_extended == true &&
-        state.middle_extended == true &&
-        state.ring_extended == false &&
-        state.pinky_extended == false &&
-        state.thumb_extended == false)
+    for (; i < n; i++)
     {
-        return {GestureID::Peace, state};
+        const HandLandmarkResult hand = hands.at(i);
+        const std::uint8_t bits = finger_mask(extract_finger_state(hand));
+
+        if (out_masks != nullptr)
+            out_masks[i] = bits;
+        if (out_gestures != nullptr)
+            out_gestures[i] = builtin_gesture(
+                bits, is_thumb_pointing_up(hand.points[ThumbMcp], hand.points[ThumbIp], hand.points[ThumbTip]));
     }
+}
 
-    if (state.index_extended == false &&
-        state.middle_extended == false &&
-        state.ring_extended == false &&
-        state.pinky_extended == false &&
-        state.thumb_extended == true &&
-        is_thumb_pointing_up(data.points[ThumbMcp],
-                                data.points[ThumbIp],
-                                data.points[ThumbTip]))
+void extract_finger_state_batch(const HandLandmarkBatch &hands, std::uint8_t *out_masks)
+{
+    classify_batch(hands, nullptr, out_masks);
+}
+
+void classify_hand_gesture_batch(const HandLandmarkBatch &hands, GestureID *out_gestures, std::uint8_t *out_masks)
+{
+    classify_batch(hands, out_gestures, out_masks);
+}
+
+void can_classify_hand_batch(const HandLandmarkBatch &hands, std::uint8_t *out_ok)
+{
+    const std::size_t n = hands.size();
+    std::size_t i = 0;
+
+#if CV_SIMD128
+    for (; i + 4 <= n; i += 4)
     {
-        return {GestureID::ThumbsUp, state};
+        const cv::v_float32x4 palm_scale = v_distance(
+            cv::v_load(hands.x[Wrist].data() + i), cv::v_load(hands.y[Wrist].data() + i),
+            cv::v_load(hands.x[MiddleMcp].data() + i), cv::v_load(hands.y[MiddleMcp].data() + i));
+
+        // Rejections mirror the scalar early returns, so NaNs pass the same way.
+        const int rejected =
+            cv::v_signmask(cv::v_load(hands.confidence.data() + i) < cv::v_setall_f32(0.7f)) |
+            cv::v_signmask(palm_scale < cv::v_setall_f32(min_palm_scale));
+
+        for (int lane = 0; lane < 4; lane++)
+            out_ok[i + lane] = (hands.has_hand[i + lane] != 0 && ((rejected >> lane) & 1) == 0) ? 1 : 0;
     }
+#endif
 
-    return {GestureID::Unknown, state};
+    for (; i < n; i++)
+        out_ok[i] = can_classify_hand(hands.at(i)) ? 1 : 0;
 }
 
 }
\ No newline at end of file
@@ -1,39 +1,52 @@
 #include "cvtool/core/gesture/hand_landmark_detector.hpp"
+#include "cvtool/core/gesture/tensor_prep.hpp"
 
-#include <opencv2/dnn.hpp>
+#include <opencv2/imgproc.hpp>
 
 #include <fmt/format.h>
 
 #include <array>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 
 namespace cvtool::core::gesture
 {
 
-    cv::Mat HandLandmarkDetector::preprocess_image(const cv::Mat &frame)
+    void HandLandmarkDetector::preprocess_image(const std::vector<cv::Mat> &crops)
     {
-        return cv::dnn::blobFromImage(
-            frame,
-            1.0 / 255.0,
-            cv::Size(input_width_, input_height_),
-            cv::Scalar(),
-            true,
-            false,
-            CV_32F);
+        const std::size_t slot = static_cast<std::size_t>(3 * input_width_ * input_height_);
+        input_buffer_.resize(slot * crops.size());
+
+        const cv::Size input_size(input_width_, input_height_);
+        for (std::size_t i = 0; i < crops.size(); i++)
+        {
+            const cv::Mat *src = &crops[i];
+            if (src->size() != input_size)
+            {
+                cv::resize(*src, resize_buffer_, input_size, 0, 0, cv::INTER_LINEAR);
+                src = &resize_buffer_;
+            }
+
+            pack_bgr_to_rgb_planar(*src, input_buffer_.data() + (i * slot), 0.0f, 1.0f / 255.0f);
+        }
     }
 
-    Ort::Value HandLandmarkDetector::create_input_tensor(const cv::Mat &blob)
+    Ort::Value HandLandmarkDetector::create_input_tensor(std::size_t batch)
     {
+        std::array<int64_t, 4> shape = input_shape_;
+        shape[0] = static_cast<int64_t>(batch);
+
         auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
         Ort::Value input_tensor = Ort::Value::CreateTensor<float>(
-            memory_info, const_cast<float *>(blob.ptr<float>()), blob.total(), input_shape_.data(), input_shape_.size());
+            memory_info, input_buffer_.data(), input_buffer_.size(), shape.data(), shape.size());
 
         return input_tensor;
     }
 
     cvtool::core::gesture::HandLandmarkResult HandLandmarkDetector::decode_output(
-        std::vector<Ort::Value> &out_tensor, const cv::Mat &frame, const cv::Rect &roi)
+        std::vector<Ort::Value> &out_tensor, std::size_t index, std::size_t batch,
+        const cv::Mat &frame, const cv::Rect &roi)
     {
         cvtool::core::gesture::HandLandmarkResult result{};
 
@@ -46,12 +59,12 @@ namespace cvtool::core::gesture
         std::size_t total_size_score = info_score.GetElementCount();
         auto info_lr = out_tensor[2].GetTensorTypeAndShapeInfo();
         std::size_t total_size_lr = info_lr.GetElementCount();
-        if (total_size_xyz != 63 || total_size_score != 1 || total_size_lr != 1)
+        if (total_size_xyz != 63 * batch || total_size_score != batch || total_size_lr != batch)
             return result;
 
-        float *xyz = out_tensor[0].GetTensorMutableData<float>();
-        float *hand_score = out_tensor[1].GetTensorMutableData<float>();
-        float *lefthand_righthand = out_tensor[2].GetTensorMutableData<float>();
+        const float *xyz = out_tensor[0].GetTensorMutableData<float>() + index * 63;
+        const float *hand_score = out_tensor[1].GetTensorMutableData<float>() + index;
+        const float *lefthand_righthand = out_tensor[2].GetTensorMutableData<float>() + index;
 
         if (hand_score[0] <= min_hand_score_)
             return result;
@@ -115,9 +128,15 @@ namespace cvtool::core::gesture
         return result;
     }
 
+    static double elapsed_ms(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+
     cvtool::core::ExitCode HandLandmarkDetector::initialize(
         const std::string &model_path, std::string &err)
     {
+        load_timings_ = {};
         env_ = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_FATAL, "Default");
 
         if (model_path.empty())
@@ -144,6 +163,16 @@ namespace cvtool::core::gesture
             return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
         }
 
+        const auto read_start = std::chrono::steady_clock::now();
+        std::vector<char> model_bytes;
+        const auto read_code = read_model_file(model_path, model_bytes, err);
+        if (read_code != cvtool::core::ExitCode::Ok)
+        {
+            initialized_ = false;
+            return read_code;
+        }
+        load_timings_.read_ms = elapsed_ms(read_start);
+
         session_option_.SetIntraOpNumThreads(2);
         session_option_.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
         session_option_.SetLogSeverityLevel(ORT_LOGGING_LEVEL_FATAL);
@@ -151,7 +180,23 @@ namespace cvtool::core::gesture
 
         try
         {
-            session_ = std::make_unique<Ort::Session>(*env_, model_fs_path.c_str(), session_option_);
+            const auto session_start = std::chrono::steady_clock::now();
+            session_ = std::make_unique<Ort::Session>(*env_, model_bytes.data(), model_bytes.size(), session_option_);
+            load_timings_.session_ms = elapsed_ms(session_start);
+
+            const auto model_input_info = session_->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo();
+            if (model_input_info.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+            {
+                err = fmt::format("error: HandLandmarkDetector::initialize: model input must be float32: {}\n"
+                                  "quantized models must keep float inputs (QDQ format)",
+                                  model_path);
+                initialized_ = false;
+                return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+            }
+
+            const auto model_input_shape = model_input_info.GetShape();
+            dynamic_batch_ = !model_input_shape.empty() && model_input_shape[0] <= 0;
+
             initialized_ = true;
             return cvtool::core::ExitCode::Ok;
         }
@@ -166,30 +211,154 @@ namespace cvtool::core::gesture
         }
     }
 
-    cvtool::core::gesture::HandLandmarkResult HandLandmarkDetector::detect(
-        const cv::Mat &frame, const cv::Rect &roi)
+    cvtool::core::ExitCode HandLandmarkDetector::warm_up(int runs, std::string &err, std::size_t batch)
     {
-        HandLandmarkResult result{};
+        if (!initialized_)
+        {
+            err = "error: HandLandmarkDetector::warm_up: detector is not initialized";
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
 
-        if (initialized_ == false)
-            return result;
+        const auto warmup_start = std::chrono::steady_clock::now();
+        std::vector<std::size_t> batches{1};
+        if (dynamic_batch_ && batch > 1)
+            batches.push_back(batch);
 
-        const auto run_inference = [&](const cv::Rect &used_roi) -> HandLandmarkResult
+        try
+        {
+            for (int r = 0; r < runs; r++)
+            {
+                for (const auto b : batches)
+                {
+                    input_buffer_.assign(static_cast<std::size_t>(3 * input_width_ * input_height_) * b, 0.0f);
+                    Ort::Value input_tensor = create_input_tensor(b);
+                    session_->Run(
+                        Ort::RunOptions{nullptr},
+                        input_names_.data(),
+                        &input_tensor, 1,
+                        output_names_.data(), output_names_.size());
+                }
+            }
+        }
+        catch (const Ort::Exception &e)
+        {
+            err = fmt::format("error: HandLandmarkDetector::warm_up: ORT error: {}", e.what());
+            return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+        }
+
+        load_timings_.warmup_ms = elapsed_ms(warmup_start);
+        return cvtool::core::ExitCode::Ok;
+    }
+
+    cv::Mat HandLandmarkDetector::input_blob(const cv::Mat &frame, const cv::Rect &roi)
+    {
+        const cv::Rect used_roi = roi & cv::Rect(0, 0, frame.cols, frame.rows);
+        preprocess_image({used_roi.empty() ? frame : frame(used_roi)});
+
+        const int sizes[4] = {1, 3, input_height_, input_width_};
+        return cv::Mat(4, sizes, CV_32F, input_buffer_.data()).clone();
+    }
+
+    std::vector<cvtool::core::gesture::HandLandmarkResult> HandLandmarkDetector::run_batch(
+        const std::vector<HandCrop> &crops)
+    {
+        std::vector<HandLandmarkResult> results(crops.size());
+        if (crops.empty())
+            return results;
+
+        std::vector<cv::Mat> local_frames;
+        local_frames.reserve(crops.size());
+        for (const auto &crop : crops)
+            local_frames.push_back(crop.roi.empty() ? crop.frame : crop.frame(crop.roi));
+
+        const auto run_chunk = [&](std::size_t first, std::size_t count)
         {
-            HandLandmarkResult local_result{};
+            const std::vector<cv::Mat> chunk(
+                local_frames.begin() + first, local_frames.begin() + first + count);
 
-            cv::Mat local_frame = used_roi.empty() ? frame : frame(used_roi);
-            cv::Mat blob = preprocess_image(local_frame);
-            Ort::Value input_tensor = create_input_tensor(blob);
+            preprocess_image(chunk);
+            Ort::Value input_tensor = create_input_tensor(count);
 
             auto output_tensors = session_->Run(
                 Ort::RunOptions{nullptr},
                 input_names_.data(),
                 &input_tensor, 1,
-                output_names_.data(), 3);
+                output_names_.data(), output_names_.size());
+
+            if (output_tensors.size() < output_names_.size())
+                return;
+
+            for (std::size_t i = 0; i < count; i++)
+                results[first + i] = decode_output(
+                    output_tensors, i, count, crops[first + i].frame, crops[first + i].roi);
+        };
+
+        if (dynamic_batch_)
+        {
+            run_chunk(0, crops.size());
+        }
+        else
+        {
+            for (std::size_t i = 0; i < crops.size(); i++)
+                run_chunk(i, 1);
+        }
+
+        return results;
+    }
+
+    std::vector<cvtool::core::gesture::HandLandmarkResult> HandLandmarkDetector::detect_batch(
+        const std::vector<HandCrop> &crops)
+    {
+        if (initialized_ == false)
+            return std::vector<HandLandmarkResult>(crops.size());
+
+        std::vector<HandCrop> clipped;
+        clipped.reserve(crops.size());
+        for (const auto &crop : crops)
+        {
+            const cv::Rect frame_rect(0, 0, crop.frame.cols, crop.frame.rows);
+            const cv::Rect used_roi = crop.roi.empty() ? cv::Rect() : (crop.roi & frame_rect);
+            clipped.push_back({crop.frame, used_roi});
+        }
+
+        try
+        {
+            return run_batch(clipped);
+        }
+        catch (const Ort::Exception &e)
+        {
+            last_error_ = e.what();
+        }
+        catch (const std::exception &e)
+        {
+            last_error_ = e.what();
+        }
+
+        return std::vector<HandLandmarkResult>(crops.size());
+    }
+
+    std::vector<cvtool::core::gesture::HandLandmarkResult> HandLandmarkDetector::detect_batch(
+        const cv::Mat &frame, const std::vector<cv::Rect> &rois)
+    {
+        std::vector<HandCrop> crops;
+        crops.reserve(rois.size());
+        for (const auto &r : rois)
+            crops.push_back({frame, r});
+
+        return detect_batch(crops);
+    }
+
+    cvtool::core::gesture::HandLandmarkResult HandLandmarkDetector::detect(
+        const cv::Mat &frame, const cv::Rect &roi)
+    {
+        HandLandmarkResult result{};
+
+        if (initialized_ == false)
+            return result;
 
-            local_result = decode_output(output_tensors, frame, used_roi);
-            return local_result;
+        const auto run_inference = [&](const cv::Rect &used_roi) -> HandLandmarkResult
+        {
+            return run_batch({HandCrop{frame, used_roi}}).front();
         };
 
         try
@@ -220,6 +389,36 @@ namespace cvtool::core::gesture
                 tight_roi.height + (2 * pad_y));
             const cv::Rect expanded_roi = expanded_raw & frame_rect;
 
+            constexpr int expanded_after_misses = 2;
+            constexpr int expanded_retry_period = 2;
+            const auto should_try_expanded = [&](int miss_streak)
+            {
+                return miss_streak >= expanded_after_misses &&
+                       (miss_streak % expanded_retry_period) == 0 &&
+                       !expanded_roi.empty() && expanded_roi != tight_roi;
+            };
+
+            // If a tight miss on this frame would trigger the expanded retry anyway,
+            // run both crops in one batched call instead of two sequential ones.
+            if (dynamic_batch_ && should_try_expanded(tight_miss_streak_ + 1))
+            {
+                auto both = run_batch({HandCrop{frame, tight_roi}, HandCrop{frame, expanded_roi}});
+                if (both[0].has_hand)
+                {
+                    tight_miss_streak_ = 0;
+                    return both[0];
+                }
+
+                tight_miss_streak_++;
+                if (both[1].has_hand)
+                {
+                    tight_miss_streak_ = 0;
+                    return both[1];
+                }
+
+                return both[0];
+            }
+
             HandLandmarkResult tight_result = run_inference(tight_roi);
 
             if (tight_result.has_hand)
@@ -230,13 +429,7 @@ namespace cvtool::core::gesture
 
             tight_miss_streak_++;
 
-            constexpr int expanded_after_misses = 2;
-            constexpr int expanded_retry_period = 2;
-            const bool should_try_expanded =
-                tight_miss_streak_ >= expanded_after_misses &&
-                (tight_miss_streak_ % expanded_retry_period) == 0;
-
-            if (should_try_expanded && !expanded_roi.empty() && expanded_roi != tight_roi)
+            if (should_try_expanded(tight_miss_streak_))
             {
                 HandLandmarkResult expanded_result = run_inference(expanded_roi);
                 if (expanded_result.has_hand)
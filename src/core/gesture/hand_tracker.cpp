@@ -0,0 +1,193 @@
+#include "cvtool/core/gesture/hand_tracker.hpp"
+
+#include <algorithm>
+
+namespace cvtool::core::gesture
+{
+
+static double iou_rect(const cv::Rect &a, const cv::Rect &b)
+{
+    const double inter = (a & b).area();
+    const double uni = static_cast<double>(a.area()) + static_cast<double>(b.area()) - inter;
+    return uni > 0.0 ? inter / uni : 0.0;
+}
+
+static cv::Rect tracking_crop(const cv::Rect &bbox, const cv::Rect &bounds)
+{
+    const int side = std::max(32, static_cast<int>(std::max(bbox.width, bbox.height) * 1.5f));
+    const int cx = bbox.x + (bbox.width / 2);
+    const int cy = bbox.y + (bbox.height / 2);
+    return cv::Rect(cx - (side / 2), cy - (side / 2), side, side) & bounds;
+}
+
+void HandTracker::reset()
+{
+    tracks_.clear();
+    next_id_ = 1;
+    frames_since_discovery_ = 0;
+}
+
+bool HandTracker::needs_inference() const
+{
+    return tracks_.empty() ||
+           std::any_of(tracks_.begin(), tracks_.end(),
+                       [](const HandTrack &t) { return !t.hand.has_hand; });
+}
+
+void HandTracker::apply_detection(
+    HandTrack &track, const HandLandmarkResult &detection, std::chrono::steady_clock::time_point time_now)
+{
+    track.hand = cfg_.smooth ? track.filter.update(detection, time_now) : detection;
+    track.search_bbox = detection.hand_bbox;
+    track.missed = 0;
+    track.updated = true;
+    track.predicted = false;
+}
+
+void HandTracker::update(
+    HandLandmarkDetector &detector, const cv::Mat &frame, const cv::Rect &roi,
+    bool run_inference, std::chrono::steady_clock::time_point time_now)
+{
+    for (auto &track : tracks_)
+    {
+        track.updated = false;
+        track.predicted = false;
+    }
+
+    if (!run_inference)
+    {
+        if (!cfg_.smooth)
+            return;
+
+        for (auto &track : tracks_)
+        {
+            if (track.hand.has_hand && track.filter.has_state())
+            {
+                track.hand = track.filter.predict(time_now);
+                track.predicted = true;
+            }
+        }
+        return;
+    }
+
+    const cv::Rect frame_rect(0, 0, frame.cols, frame.rows);
+    const cv::Rect area = roi.empty() ? frame_rect : (roi & frame_rect);
+    if (area.empty())
+    {
+        reset();
+        return;
+    }
+
+    std::vector<cv::Rect> crops;
+    crops.reserve(tracks_.size() + 3);
+    for (const auto &track : tracks_)
+        crops.push_back(tracking_crop(track.search_bbox, area));
+
+    const std::size_t discovery_begin = crops.size();
+    frames_since_discovery_++;
+
+    const bool track_lost = std::any_of(tracks_.begin(), tracks_.end(),
+                                        [](const HandTrack &t) { return !t.hand.has_hand; });
+    const bool discover = static_cast<int>(tracks_.size()) < cfg_.max_hands &&
+                          (tracks_.empty() || track_lost || frames_since_discovery_ >= cfg_.discovery_interval);
+    if (discover)
+    {
+        frames_since_discovery_ = 0;
+
+        if (tracks_.empty())
+        {
+            crops.push_back(area);
+        }
+        else
+        {
+            // The landmark model sees one hand per crop, so further users are looked for
+            // in the halves; a half holding a tracked hand would only find that hand again.
+            // The two halves overlap and cover the whole area, so no full-area crop is needed.
+            const int half_w = (area.width * 3) / 5;
+            const int mid_x = area.x + (area.width / 2);
+            bool left_taken{false};
+            bool right_taken{false};
+            for (const auto &track : tracks_)
+            {
+                if (!track.hand.has_hand)
+                    continue;
+                const int cx = track.search_bbox.x + (track.search_bbox.width / 2);
+                (cx < mid_x ? left_taken : right_taken) = true;
+            }
+
+            if (!left_taken)
+                crops.push_back(cv::Rect(area.x, area.y, half_w, area.height));
+            if (!right_taken)
+                crops.push_back(cv::Rect(area.x + area.width - half_w, area.y, half_w, area.height));
+        }
+    }
+
+    const auto results = detector.detect_batch(frame, crops);
+
+    for (std::size_t i = 0; i < discovery_begin; i++)
+    {
+        HandTrack &track = tracks_[i];
+        if (results[i].has_hand)
+        {
+            apply_detection(track, results[i], time_now);
+        }
+        else
+        {
+            track.hand = HandLandmarkResult{};
+            track.filter.reset();
+            track.updated = true;
+            track.missed++;
+        }
+    }
+
+    std::vector<const HandLandmarkResult *> discovered;
+    for (std::size_t i = discovery_begin; i < results.size(); i++)
+    {
+        if (results[i].has_hand)
+            discovered.push_back(&results[i]);
+    }
+    std::sort(discovered.begin(), discovered.end(),
+              [](const HandLandmarkResult *a, const HandLandmarkResult *b)
+              { return a->confidence > b->confidence; });
+
+    for (const HandLandmarkResult *candidate : discovered)
+    {
+        auto owner = std::find_if(
+            tracks_.begin(), tracks_.end(),
+            [&](const HandTrack &t)
+            { return iou_rect(t.search_bbox, candidate->hand_bbox) > cfg_.match_iou; });
+
+        if (owner != tracks_.end())
+        {
+            if (!owner->hand.has_hand)
+                apply_detection(*owner, *candidate, time_now);
+            continue;
+        }
+
+        if (static_cast<int>(tracks_.size()) >= cfg_.max_hands)
+            continue;
+
+        tracks_.emplace_back(next_id_++, cfg_);
+        apply_detection(tracks_.back(), *candidate, time_now);
+    }
+
+    // Two tracks that latched onto the same hand: keep the older one.
+    for (std::size_t i = 0; i < tracks_.size(); i++)
+    {
+        for (std::size_t j = i + 1; j < tracks_.size(); j++)
+        {
+            if (tracks_[i].hand.has_hand && tracks_[j].hand.has_hand &&
+                iou_rect(tracks_[i].hand.hand_bbox, tracks_[j].hand.hand_bbox) > cfg_.duplicate_iou)
+            {
+                tracks_[j].hand = HandLandmarkResult{};
+                tracks_[j].missed = cfg_.max_missed + 1;
+            }
+        }
+    }
+
+    tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(),
+                                 [&](const HandTrack &t) { return t.missed > cfg_.max_missed; }),
+                  tracks_.end());
+}
+
+}
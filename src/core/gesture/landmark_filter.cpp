@@ -0,0 +1,83 @@
+#include "cvtool/core/gesture/landmark_filter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace cvtool::core::gesture
+{
+
+static float smoothing_alpha(float cutoff, float dt)
+{
+    const float tau = 1.0f / (2.0f * std::numbers::pi_v<float> * cutoff);
+    return 1.0f / (1.0f + tau / dt);
+}
+
+void LandmarkFilter::reset()
+{
+    has_state_ = false;
+    last_time_ = std::chrono::steady_clock::time_point();
+    position_.fill(cv::Point2f(0.0f, 0.0f));
+    velocity_.fill(cv::Point2f(0.0f, 0.0f));
+    last_ = HandLandmarkResult{};
+}
+
+HandLandmarkResult LandmarkFilter::update(
+    const HandLandmarkResult &raw, std::chrono::steady_clock::time_point time_now)
+{
+    if (!raw.has_hand)
+    {
+        reset();
+        return raw;
+    }
+
+    const float dt = std::chrono::duration<float>(time_now - last_time_).count();
+    if (!has_state_ || dt <= 0.0f)
+    {
+        position_ = raw.points;
+        velocity_.fill(cv::Point2f(0.0f, 0.0f));
+        has_state_ = true;
+        last_time_ = time_now;
+        last_ = raw;
+        return raw;
+    }
+
+    const float alpha_d = smoothing_alpha(d_cutoff_, dt);
+    for (std::size_t i = 0; i < position_.size(); i++)
+    {
+        const cv::Point2f raw_velocity = (raw.points[i] - position_[i]) * (1.0f / dt);
+        velocity_[i] = velocity_[i] + (raw_velocity - velocity_[i]) * alpha_d;
+
+        const float speed = std::hypot(velocity_[i].x, velocity_[i].y);
+        const float alpha = smoothing_alpha(min_cutoff_ + beta_ * speed, dt);
+        position_[i] = position_[i] + (raw.points[i] - position_[i]) * alpha;
+    }
+    last_time_ = time_now;
+
+    last_ = raw;
+    last_.points = position_;
+    last_.hand_bbox = cv::boundingRect(last_.points);
+
+    return last_;
+}
+
+HandLandmarkResult LandmarkFilter::predict(std::chrono::steady_clock::time_point time_now) const
+{
+    if (!has_state_)
+        return HandLandmarkResult{};
+
+    const auto ahead = std::clamp(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(time_now - last_time_),
+        std::chrono::steady_clock::duration::zero(),
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(max_predict_));
+    const float dt = std::chrono::duration<float>(ahead).count();
+
+    HandLandmarkResult result = last_;
+    for (std::size_t i = 0; i < position_.size(); i++)
+        result.points[i] = position_[i] + velocity_[i] * dt;
+    result.hand_bbox = cv::boundingRect(result.points);
+
+    return result;
+}
+
+}
@@ -0,0 +1,172 @@
+#include "cvtool/core/gesture/landmark_record.hpp"
+
+#include <fmt/format.h>
+
+#include <bit>
+
+namespace cvtool::core::gesture
+{
+
+static_assert(std::endian::native == std::endian::little, "landmark records are written in native little-endian layout");
+
+RecordedHand to_recorded_hand(const HandLandmarkResult &hand, int track_id, bool updated, bool predicted)
+{
+    RecordedHand out;
+    out.track_id = track_id;
+    out.has_hand = hand.has_hand ? 1 : 0;
+    out.handedness = static_cast<std::uint8_t>(hand.hand);
+    out.updated = updated ? 1 : 0;
+    out.predicted = predicted ? 1 : 0;
+    out.confidence = hand.confidence;
+    for (std::size_t k = 0; k < hand.points.size(); k++)
+    {
+        out.points[2 * k] = hand.points[k].x;
+        out.points[2 * k + 1] = hand.points[k].y;
+    }
+
+    return out;
+}
+
+HandLandmarkResult to_hand_result(const RecordedHand &hand)
+{
+    HandLandmarkResult out;
+    out.has_hand = hand.has_hand != 0;
+    out.hand = hand.handedness <= static_cast<std::uint8_t>(Handedness::None)
+                   ? static_cast<Handedness>(hand.handedness)
+                   : Handedness::None;
+    out.confidence = hand.confidence;
+    for (std::size_t k = 0; k < out.points.size(); k++)
+        out.points[k] = cv::Point2f(hand.points[2 * k], hand.points[2 * k + 1]);
+
+    return out;
+}
+
+RecordedFace to_recorded_face(const FaceLandmarkResult &face)
+{
+    RecordedFace out;
+    out.has_face = face.has_face ? 1 : 0;
+    out.confidence = face.confidence;
+    out.bbox = {face.bbox.x, face.bbox.y, face.bbox.width, face.bbox.height};
+    out.mouth = {face.mouth_center.x, face.mouth_center.y,
+                 face.mouth_left.x, face.mouth_left.y,
+                 face.mouth_right.x, face.mouth_right.y};
+
+    return out;
+}
+
+FaceLandmarkResult to_face_result(const RecordedFace &face)
+{
+    FaceLandmarkResult out;
+    out.has_face = face.has_face != 0;
+    out.confidence = face.confidence;
+    out.bbox = cv::Rect(face.bbox[0], face.bbox[1], face.bbox[2], face.bbox[3]);
+    out.mouth_center = cv::Point2f(face.mouth[0], face.mouth[1]);
+    out.mouth_left = cv::Point2f(face.mouth[2], face.mouth[3]);
+    out.mouth_right = cv::Point2f(face.mouth[4], face.mouth[5]);
+
+    return out;
+}
+
+cvtool::core::ExitCode LandmarkRecorder::open(const std::string &path, int max_hands, std::string &err)
+{
+    path_ = path;
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_)
+    {
+        err = fmt::format("error: cannot open landmark recording for writing: {}", path);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    LandmarkRecordHeader header;
+    header.record_size = sizeof(LandmarkRecord);
+    header.max_hands = static_cast<std::uint32_t>(max_hands);
+    file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!file_)
+    {
+        err = fmt::format("error: failed to write landmark recording: {}", path);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+cvtool::core::ExitCode LandmarkRecorder::write(const LandmarkRecord &record, std::string &err)
+{
+    file_.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    if (!file_)
+    {
+        err = fmt::format("error: failed to write landmark recording: {}", path_);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+cvtool::core::ExitCode LandmarkRecorder::close(std::string &err)
+{
+    if (!file_.is_open())
+        return cvtool::core::ExitCode::Ok;
+
+    file_.close();
+    if (file_.fail())
+    {
+        err = fmt::format("error: failed to finish landmark recording: {}", path_);
+        return cvtool::core::ExitCode::CannotWriteOutput;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+cvtool::core::ExitCode read_landmark_records(
+    const std::string &path,
+    LandmarkRecordHeader &out_header,
+    std::vector<LandmarkRecord> &out_records,
+    std::string &err)
+{
+    out_records.clear();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        err = fmt::format("error: cannot open landmark recording: {}", path);
+        return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
+    }
+
+    const std::streamsize size = file.tellg();
+    file.seekg(0);
+    if (size < static_cast<std::streamsize>(sizeof(LandmarkRecordHeader)) ||
+        !file.read(reinterpret_cast<char *>(&out_header), sizeof(out_header)))
+    {
+        err = fmt::format("error: landmark recording is truncated: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    if (out_header.magic != landmark_record_magic)
+    {
+        err = fmt::format("error: not a landmark recording: {}", path);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+    if (out_header.version != landmark_record_version || out_header.record_size != sizeof(LandmarkRecord))
+    {
+        err = fmt::format("error: unsupported landmark recording (version {}, record size {}): {}",
+                          out_header.version, out_header.record_size, path);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    const auto payload = static_cast<std::size_t>(size) - sizeof(LandmarkRecordHeader);
+    const std::size_t count = payload / sizeof(LandmarkRecord);
+    if (payload % sizeof(LandmarkRecord) != 0)
+        fmt::println(stderr, "warning: ignoring a partial record at the end of {}", path);
+
+    out_records.resize(count);
+    if (count > 0 && !file.read(reinterpret_cast<char *>(out_records.data()),
+                                static_cast<std::streamsize>(count * sizeof(LandmarkRecord))))
+    {
+        err = fmt::format("error: cannot read landmark recording: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+}
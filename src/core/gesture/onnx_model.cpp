@@ -0,0 +1,39 @@
+#include "cvtool/core/gesture/onnx_model.hpp"
+
+#include <fmt/format.h>
+
+#include <fstream>
+
+namespace cvtool::core::gesture
+{
+
+cvtool::core::ExitCode read_model_file(const std::string &model_path, std::vector<char> &out_bytes, std::string &err)
+{
+    out_bytes.clear();
+
+    std::ifstream file(model_path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        err = fmt::format("error: cannot open model file: {}", model_path);
+        return cvtool::core::ExitCode::InputNotFoundOrNoAccess;
+    }
+
+    const std::streamsize size = file.tellg();
+    if (size <= 0)
+    {
+        err = fmt::format("error: model file is empty: {}", model_path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    out_bytes.resize(static_cast<std::size_t>(size));
+    file.seekg(0);
+    if (!file.read(out_bytes.data(), size))
+    {
+        err = fmt::format("error: cannot read model file: {}", model_path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+}
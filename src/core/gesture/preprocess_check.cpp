@@ -0,0 +1,165 @@
+#include "cvtool/core/gesture/preprocess_check.hpp"
+#include "cvtool/core/gesture/face_landmark_detector.hpp"
+#include "cvtool/core/gesture/hand_landmark_detector.hpp"
+#include "cvtool/core/gesture/tensor_prep.hpp"
+
+#include <opencv2/dnn.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace cvtool::core::gesture
+{
+
+// Number of floats that differ bit for bit, and the largest absolute difference.
+static std::size_t count_mismatches(const float *a, const float *b, std::size_t n, float &max_diff)
+{
+    std::size_t mismatches{0};
+    max_diff = 0.0f;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (std::memcmp(a + i, b + i, sizeof(float)) != 0)
+        {
+            mismatches++;
+            max_diff = std::max(max_diff, std::abs(a[i] - b[i]));
+        }
+    }
+    return mismatches;
+}
+
+static std::size_t count_mismatches(const cv::Mat &a, const cv::Mat &b, float &max_diff)
+{
+    if (a.total() != b.total())
+    {
+        max_diff = 0.0f;
+        return std::max(a.total(), b.total());
+    }
+    return count_mismatches(a.ptr<float>(), b.ptr<float>(), a.total(), max_diff);
+}
+
+// The hand tensor as it was built before the fused packing.
+static cv::Mat reference_hand_blob(const cv::Mat &crop, int input_size)
+{
+    return cv::dnn::blobFromImage(
+        crop, 1.0 / 255.0, cv::Size(input_size, input_size), cv::Scalar(), true, false, CV_32F);
+}
+
+// The face tensor as it was built before the fused packing: a fresh zero canvas
+// for every frame, letterboxed into its top-left corner.
+static cv::Mat reference_face_blob(const cv::Mat &crop, int input_size)
+{
+    const float s = std::min(static_cast<float>(input_size) / static_cast<float>(crop.cols),
+                             static_cast<float>(input_size) / static_cast<float>(crop.rows));
+    const int rw = std::clamp(static_cast<int>(std::lround(crop.cols * s)), 1, input_size);
+    const int rh = std::clamp(static_cast<int>(std::lround(crop.rows * s)), 1, input_size);
+
+    cv::Mat canvas(input_size, input_size, CV_8UC3, cv::Scalar(0, 0, 0));
+    cv::Mat content = canvas(cv::Rect(0, 0, rw, rh));
+    cv::resize(crop, content, content.size());
+
+    cv::Mat canvas_rgb;
+    cv::cvtColor(canvas, canvas_rgb, cv::COLOR_BGR2RGB);
+    return cv::dnn::blobFromImage(
+        canvas_rgb, 1.0 / 128.0, cv::Size(input_size, input_size), cv::Scalar(127.5, 127.5, 127.5), false, false);
+}
+
+// Crops follow each other so that the detectors' reused buffers see every transition:
+// a random size, a larger crop, a smaller one, the previous aspect turned around, and
+// an exact hand input size (no resize). Widths are odd where possible, so the SIMD
+// packer runs its scalar tail.
+static cv::Size next_crop_size(int i, const cv::Size &prev, const cv::Size &frame, int hand_input, cv::RNG &rng)
+{
+    int w{1}, h{1};
+    switch (i % 5)
+    {
+    case 0:
+        w = rng.uniform(1, 320) | 1;
+        h = rng.uniform(1, 320);
+        break;
+    case 1:
+        w = (prev.width * 2) | 1;
+        h = prev.height * 2 + 1;
+        break;
+    case 2:
+        w = (prev.width / 3) | 1;
+        h = std::max(prev.height / 3, 1);
+        break;
+    case 3:
+        w = prev.height | 1;
+        h = prev.width;
+        break;
+    default:
+        w = hand_input;
+        h = hand_input;
+        break;
+    }
+    return {std::min(w, frame.width), std::min(h, frame.height)};
+}
+
+cvtool::core::ExitCode verify_preprocessing(int cases, std::string &report, std::string &err)
+{
+    // Neither input_blob() needs a loaded model; the sizes are the detectors' defaults.
+    constexpr int hand_input = 224;
+    constexpr int face_input = 640;
+    HandLandmarkDetector hand_detector;
+    FaceLandmarkDetector face_detector;
+
+    cv::RNG rng(0x5eed);
+    cv::Mat frame(720, 1281, CV_8UC3);
+    rng.fill(frame, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    report.clear();
+    std::size_t failed{0};
+    cv::Size size(1, 1);
+
+    for (int i = 0; i < cases; i++)
+    {
+        size = next_crop_size(i, size, frame.size(), hand_input, rng);
+        const int x = rng.uniform(0, frame.cols - size.width + 1);
+        const int y = rng.uniform(0, frame.rows - size.height + 1);
+        const cv::Rect roi(x, y, size.width, size.height);
+
+        // Crops are ROIs, so rows are not contiguous.
+        const cv::Mat crop = frame(roi);
+
+        // Packers alone, on the raw crop.
+        const std::size_t crop_n = 3 * crop.total();
+        std::vector<float> simd(crop_n), scalar(crop_n);
+        pack_bgr_to_rgb_planar(crop, simd.data(), 0.0f, 1.0f / 255.0f);
+        pack_bgr_to_rgb_planar_scalar(crop, scalar.data(), 0.0f, 1.0f / 255.0f);
+        float raw_diff{0.0f};
+        const std::size_t raw_bad = count_mismatches(simd.data(), scalar.data(), crop_n, raw_diff);
+
+        float hand_diff{0.0f};
+        const std::size_t hand_bad = count_mismatches(
+            hand_detector.input_blob(frame, roi), reference_hand_blob(crop, hand_input), hand_diff);
+
+        float face_diff{0.0f};
+        const std::size_t face_bad = count_mismatches(
+            face_detector.input_blob(frame, roi), reference_face_blob(crop, face_input), face_diff);
+
+        const bool ok = raw_bad == 0 && hand_bad == 0 && face_bad == 0;
+        if (!ok)
+            failed++;
+
+        report += fmt::format(
+            "case {}: crop {}x{} simd/scalar {} ({}) hand/blob {} ({}) face/blob {} ({}){}\n",
+            i, size.width, size.height, raw_bad, raw_diff, hand_bad, hand_diff, face_bad, face_diff,
+            ok ? "" : " MISMATCH");
+    }
+
+    if (failed > 0)
+    {
+        err = fmt::format("error: preprocessing parity failed in {} of {} cases", failed, cases);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+}
@@ -0,0 +1,87 @@
+#include "cvtool/core/gesture/tensor_prep.hpp"
+
+#include <opencv2/core/hal/intrin.hpp>
+
+#include <cstddef>
+
+namespace cvtool::core::gesture
+{
+
+#if CV_SIMD128
+static void store_normalized(
+    const cv::v_uint8x16 &px, float *dst, const cv::v_float32x4 &mean, const cv::v_float32x4 &scale)
+{
+    cv::v_uint16x8 lo16, hi16;
+    cv::v_expand(px, lo16, hi16);
+
+    cv::v_uint32x4 q0, q1, q2, q3;
+    cv::v_expand(lo16, q0, q1);
+    cv::v_expand(hi16, q2, q3);
+
+    cv::v_store(dst + 0, (cv::v_cvt_f32(cv::v_reinterpret_as_s32(q0)) - mean) * scale);
+    cv::v_store(dst + 4, (cv::v_cvt_f32(cv::v_reinterpret_as_s32(q1)) - mean) * scale);
+    cv::v_store(dst + 8, (cv::v_cvt_f32(cv::v_reinterpret_as_s32(q2)) - mean) * scale);
+    cv::v_store(dst + 12, (cv::v_cvt_f32(cv::v_reinterpret_as_s32(q3)) - mean) * scale);
+}
+#endif
+
+static void pack_row_scalar(
+    const uchar *src, int x, int width, float *dst_r, float *dst_g, float *dst_b, float mean, float scale)
+{
+    for (; x < width; x++)
+    {
+        dst_r[x] = (static_cast<float>(src[(x * 3) + 2]) - mean) * scale;
+        dst_g[x] = (static_cast<float>(src[(x * 3) + 1]) - mean) * scale;
+        dst_b[x] = (static_cast<float>(src[(x * 3) + 0]) - mean) * scale;
+    }
+}
+
+void pack_bgr_to_rgb_planar_scalar(const cv::Mat &bgr, float *dst, float mean, float scale)
+{
+    CV_Assert(bgr.type() == CV_8UC3);
+
+    const std::size_t plane = static_cast<std::size_t>(bgr.rows) * static_cast<std::size_t>(bgr.cols);
+    for (int y = 0; y < bgr.rows; y++)
+    {
+        const std::size_t row = static_cast<std::size_t>(y) * static_cast<std::size_t>(bgr.cols);
+        pack_row_scalar(bgr.ptr<uchar>(y), 0, bgr.cols, dst + row, dst + plane + row, dst + (2 * plane) + row, mean, scale);
+    }
+}
+
+void pack_bgr_to_rgb_planar(const cv::Mat &bgr, float *dst, float mean, float scale)
+{
+    CV_Assert(bgr.type() == CV_8UC3);
+
+    const int width = bgr.cols;
+    const std::size_t plane = static_cast<std::size_t>(bgr.rows) * static_cast<std::size_t>(width);
+    float *dst_r = dst;
+    float *dst_g = dst + plane;
+    float *dst_b = dst + (2 * plane);
+
+#if CV_SIMD128
+    const cv::v_float32x4 v_mean = cv::v_setall_f32(mean);
+    const cv::v_float32x4 v_scale = cv::v_setall_f32(scale);
+#endif
+
+    for (int y = 0; y < bgr.rows; y++)
+    {
+        const uchar *src = bgr.ptr<uchar>(y);
+        const std::size_t row = static_cast<std::size_t>(y) * static_cast<std::size_t>(width);
+        int x = 0;
+
+#if CV_SIMD128
+        for (; x <= width - 16; x += 16)
+        {
+            cv::v_uint8x16 b, g, r;
+            cv::v_load_deinterleave(src + (x * 3), b, g, r);
+            store_normalized(r, dst_r + row + x, v_mean, v_scale);
+            store_normalized(g, dst_g + row + x, v_mean, v_scale);
+            store_normalized(b, dst_b + row + x, v_mean, v_scale);
+        }
+#endif
+
+        pack_row_scalar(src, x, width, dst_r + row, dst_g + row, dst_b + row, mean, scale);
+    }
+}
+
+}
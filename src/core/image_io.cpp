@@ -1,14 +1,49 @@
 #include "cvtool/core/image_io.hpp"
+#include "cvtool/core/mapped_file.hpp"
+#include "cvtool/core/image_probe.hpp"
 
 #include <opencv2/imgcodecs.hpp>
 
 #include <fmt/format.h>
+#include <algorithm>
 #include <filesystem>
+#include <limits>
 
 namespace cvtool::core::image_io
 {
 
+// imdecode flags for a JPEG that will be shrunk to fit inside max_size: the largest
+// DCT scale factor that keeps the decoded image at least as large as the fitted one.
+// IMREAD_REDUCED_* has no "unchanged" variant; JPEG only yields 1 or 3 channels, so
+// picking gray/color by the header gives the same channels as IMREAD_UNCHANGED.
+static int reduced_jpeg_flags(const unsigned char *data, std::size_t size, const cv::Size &max_size)
+{
+    cvtool::core::ImageHeader header;
+    if (max_size.width <= 0 || max_size.height <= 0 ||
+        !cvtool::core::parse_image_header(data, size, header) || header.format != "jpeg")
+        return cv::IMREAD_UNCHANGED;
+
+    const double shrink = std::max(static_cast<double>(header.width) / max_size.width,
+                                   static_cast<double>(header.height) / max_size.height);
+    const bool gray = header.channels == 1;
+
+    if (shrink >= 8.0)
+        return (gray ? cv::IMREAD_REDUCED_GRAYSCALE_8 : cv::IMREAD_REDUCED_COLOR_8) | cv::IMREAD_IGNORE_ORIENTATION;
+    if (shrink >= 4.0)
+        return (gray ? cv::IMREAD_REDUCED_GRAYSCALE_4 : cv::IMREAD_REDUCED_COLOR_4) | cv::IMREAD_IGNORE_ORIENTATION;
+    if (shrink >= 2.0)
+        return (gray ? cv::IMREAD_REDUCED_GRAYSCALE_2 : cv::IMREAD_REDUCED_COLOR_2) | cv::IMREAD_IGNORE_ORIENTATION;
+
+    return cv::IMREAD_UNCHANGED;
+}
+
 cvtool::core::ExitCode read_image(const std::string &in_path, cv::Mat &out_image, std::string &err)
+{
+    return read_image(in_path, out_image, err, cv::Size{});
+}
+
+cvtool::core::ExitCode read_image(const std::string &in_path, cv::Mat &out_image, std::string &err,
+                                  const cv::Size &max_size)
 {
     err.clear();
 
@@ -33,7 +68,21 @@ cvtool::core::ExitCode read_image(const std::string &in_path, cv::Mat &out_image
     }
     try
     {
-        cv::Mat img = cv::imread(in_path, cv::IMREAD_UNCHANGED);
+        // Decode straight from a mapping of the file; this skips imread's buffered copy.
+        // Anything that cannot be mapped (e.g. an empty or >2 GB file) still goes through imread.
+        cv::Mat img;
+        cvtool::core::MappedFile mapped;
+        std::string map_err;
+        if (mapped.open(in_path, map_err) == cvtool::core::ExitCode::Ok &&
+            mapped.size() <= static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        {
+            const cv::Mat buffer(1, static_cast<int>(mapped.size()), CV_8UC1, const_cast<unsigned char *>(mapped.data()));
+            img = cv::imdecode(buffer, reduced_jpeg_flags(mapped.data(), mapped.size(), max_size));
+        }
+        else
+        {
+            img = cv::imread(in_path, cv::IMREAD_UNCHANGED);
+        }
 
         if (img.empty())
         {
@@ -0,0 +1,375 @@
+#include "cvtool/core/image_probe.hpp"
+#include "cvtool/core/mapped_file.hpp"
+
+#include <opencv2/core/mat.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace cvtool::core
+{
+
+static std::uint32_t be16(const unsigned char *p) { return (std::uint32_t{p[0]} << 8) | p[1]; }
+static std::uint32_t le16(const unsigned char *p) { return (std::uint32_t{p[1]} << 8) | p[0]; }
+static std::uint32_t be32(const unsigned char *p) { return (be16(p) << 16) | be16(p + 2); }
+static std::uint32_t le32(const unsigned char *p) { return (le16(p + 2) << 16) | le16(p); }
+static std::uint32_t le24(const unsigned char *p) { return (std::uint32_t{p[2]} << 16) | le16(p); }
+
+static bool valid_size(std::uint64_t w, std::uint64_t h)
+{
+    return w > 0 && h > 0 && w <= 0x7fffffff && h <= 0x7fffffff;
+}
+
+static bool parse_png(const unsigned char *d, std::size_t n, ImageHeader &out)
+{
+    static constexpr unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    if (n < 33 || std::memcmp(d, signature, 8) != 0 || std::memcmp(d + 12, "IHDR", 4) != 0)
+        return false;
+
+    const std::uint32_t w = be32(d + 16);
+    const std::uint32_t h = be32(d + 20);
+    const int bit_depth = d[24];
+    const int color_type = d[25];
+    if (!valid_size(w, h))
+        return false;
+
+    // Same mapping as OpenCV's PNG decoder: palette and RGB become 4 channels when a tRNS chunk exists.
+    int channels{1};
+    switch (color_type)
+    {
+    case 0:
+        channels = 1;
+        break;
+    case 2:
+    case 3:
+    {
+        channels = 3;
+        for (std::size_t pos = 8; pos + 8 <= n;)
+        {
+            const std::uint32_t len = be32(d + pos);
+            const unsigned char *type = d + pos + 4;
+            if (std::memcmp(type, "tRNS", 4) == 0)
+            {
+                channels = 4;
+                break;
+            }
+            if (std::memcmp(type, "IDAT", 4) == 0 || std::memcmp(type, "IEND", 4) == 0)
+                break;
+            pos += std::size_t{len} + 12;
+        }
+        break;
+    }
+    case 4:
+    case 6:
+        channels = 4;
+        break;
+    default:
+        return false;
+    }
+
+    out = {"png", static_cast<int>(w), static_cast<int>(h), channels, bit_depth == 16 ? CV_16U : CV_8U};
+    return true;
+}
+
+static bool parse_jpeg(const unsigned char *d, std::size_t n, ImageHeader &out)
+{
+    if (n < 4 || d[0] != 0xff || d[1] != 0xd8)
+        return false;
+
+    std::size_t pos = 2;
+    while (pos + 4 <= n)
+    {
+        if (d[pos] != 0xff)
+            return false;
+        const unsigned char marker = d[pos + 1];
+        if (marker == 0xff)
+        {
+            pos++; // fill byte
+            continue;
+        }
+        if (marker == 0xd8 || marker == 0x01 || (marker >= 0xd0 && marker <= 0xd7))
+        {
+            pos += 2; // markers without a length
+            continue;
+        }
+        if (marker == 0xd9 || marker == 0xda)
+            return false; // EOI / SOS before any frame header
+
+        const std::size_t len = be16(d + pos + 2);
+        const bool sof = marker >= 0xc0 && marker <= 0xcf && marker != 0xc4 && marker != 0xc8 && marker != 0xcc;
+        if (sof)
+        {
+            if (len < 8 || pos + 2 + 8 > n)
+                return false;
+
+            const int precision = d[pos + 4];
+            const std::uint32_t h = be16(d + pos + 5);
+            const std::uint32_t w = be16(d + pos + 7);
+            const int components = d[pos + 9];
+            // Height 0 means "defined by a DNL marker later"; let the decoder handle that and >8-bit data.
+            if (precision != 8 || !valid_size(w, h) || (components != 1 && components != 3 && components != 4))
+                return false;
+
+            // OpenCV converts YCbCr and CMYK JPEGs to BGR.
+            out = {"jpeg", static_cast<int>(w), static_cast<int>(h), components == 1 ? 1 : 3, CV_8U};
+            return true;
+        }
+
+        if (len < 2)
+            return false;
+        pos += 2 + len;
+    }
+
+    return false;
+}
+
+static bool parse_tiff(const unsigned char *d, std::size_t n, ImageHeader &out)
+{
+    if (n < 8)
+        return false;
+
+    bool little{false};
+    if (d[0] == 'I' && d[1] == 'I' && d[2] == 42 && d[3] == 0)
+        little = true;
+    else if (!(d[0] == 'M' && d[1] == 'M' && d[2] == 0 && d[3] == 42))
+        return false; // also rejects BigTIFF (43)
+
+    const auto u16 = [&](std::size_t at) { return little ? le16(d + at) : be16(d + at); };
+    const auto u32 = [&](std::size_t at) { return little ? le32(d + at) : be32(d + at); };
+
+    const std::size_t ifd = u32(4);
+    if (ifd < 8 || ifd + 2 > n)
+        return false;
+
+    const std::size_t entries = u16(ifd);
+    if (ifd + 2 + entries * 12 > n)
+        return false;
+
+    std::uint32_t w{0};
+    std::uint32_t h{0};
+    std::uint32_t bits{1};
+    std::uint32_t samples{1};
+    std::uint32_t sample_format{1};
+    std::uint32_t photometric{1};
+
+    for (std::size_t i = 0; i < entries; i++)
+    {
+        const std::size_t e = ifd + 2 + i * 12;
+        const std::uint32_t tag = u16(e);
+        const std::uint32_t type = u16(e + 2);
+        const std::uint32_t count = u32(e + 4);
+
+        // SHORT values are left-aligned in the 4-byte field; for arrays (e.g. BitsPerSample
+        // of an RGB image) the field holds an offset and the first element is read from there.
+        std::uint32_t value{0};
+        if (type == 3)
+        {
+            std::size_t at = e + 8;
+            if (count > 2)
+            {
+                at = u32(e + 8);
+                if (at + 2 > n)
+                    return false;
+            }
+            value = u16(at);
+        }
+        else if (type == 4)
+        {
+            if (count > 1)
+                continue; // not a scalar; none of the tags below need arrays of LONGs
+            value = u32(e + 8);
+        }
+        else
+        {
+            continue;
+        }
+
+        switch (tag)
+        {
+        case 256: w = value; break;
+        case 257: h = value; break;
+        case 258: bits = value; break;
+        case 262: photometric = value; break;
+        case 277: samples = value; break;
+        case 339: sample_format = value; break;
+        default: break;
+        }
+    }
+
+    if (!valid_size(w, h))
+        return false;
+
+    // Only the layouts whose imread result is unambiguous; the rest are decoded.
+    int channels{0};
+    int depth{-1};
+    if (photometric == 3 && samples == 1 && bits <= 8)
+    {
+        channels = 3; // palette expands to BGR
+        depth = CV_8U;
+    }
+    else if ((photometric == 0 || photometric == 1) && samples == 1 && bits == 1)
+    {
+        channels = 1;
+        depth = CV_8U;
+    }
+    else if ((photometric <= 2) && (samples == 1 || samples == 3 || samples == 4))
+    {
+        channels = static_cast<int>(samples);
+        if (bits == 8 && sample_format == 1)
+            depth = CV_8U;
+        else if (bits == 16 && sample_format == 1)
+            depth = CV_16U;
+        else if (bits == 32 && sample_format == 3)
+            depth = CV_32F;
+        else if (bits == 64 && sample_format == 3)
+            depth = CV_64F;
+    }
+    if (depth < 0)
+        return false;
+
+    out = {"tiff", static_cast<int>(w), static_cast<int>(h), channels, depth};
+    return true;
+}
+
+static bool parse_bmp(const unsigned char *d, std::size_t n, ImageHeader &out)
+{
+    if (n < 26 || d[0] != 'B' || d[1] != 'M')
+        return false;
+
+    const std::uint32_t header_size = le32(d + 14);
+    std::int64_t w{0};
+    std::int64_t h{0};
+    std::uint32_t bpp{0};
+    std::uint32_t colors_used{0};
+
+    if (header_size == 12)
+    {
+        w = le16(d + 18);
+        h = le16(d + 20);
+        bpp = le16(d + 24);
+    }
+    else if (header_size >= 40 && n >= 14 + 40)
+    {
+        w = static_cast<std::int32_t>(le32(d + 18));
+        h = std::abs(static_cast<std::int64_t>(static_cast<std::int32_t>(le32(d + 22)))); // negative = top-down
+        bpp = le16(d + 28);
+        colors_used = le32(d + 46);
+    }
+    else
+    {
+        return false;
+    }
+    if (!valid_size(static_cast<std::uint64_t>(std::max<std::int64_t>(w, 0)), static_cast<std::uint64_t>(h)))
+        return false;
+
+    int channels{0};
+    if (bpp == 16 || bpp == 24)
+    {
+        channels = 3;
+    }
+    else if (bpp == 1 || bpp == 4 || bpp == 8)
+    {
+        // Like OpenCV: a palette made only of grays decodes to one channel.
+        const std::size_t entry_size = header_size == 12 ? 3 : 4;
+        const std::size_t palette = 14 + header_size;
+        const std::size_t entries = colors_used > 0 ? std::min<std::size_t>(colors_used, 256) : (std::size_t{1} << bpp);
+        if (palette + entries * entry_size > n)
+            return false;
+
+        channels = 1;
+        for (std::size_t i = 0; i < entries; i++)
+        {
+            const unsigned char *c = d + palette + i * entry_size;
+            if (c[0] != c[1] || c[1] != c[2])
+            {
+                channels = 3;
+                break;
+            }
+        }
+    }
+    else
+    {
+        return false; // 32-bit: channel count depends on the compression and masks
+    }
+
+    out = {"bmp", static_cast<int>(w), static_cast<int>(h), channels, CV_8U};
+    return true;
+}
+
+static bool parse_webp(const unsigned char *d, std::size_t n, ImageHeader &out)
+{
+    if (n < 30 || std::memcmp(d, "RIFF", 4) != 0 || std::memcmp(d + 8, "WEBP", 4) != 0)
+        return false;
+
+    std::uint32_t w{0};
+    std::uint32_t h{0};
+    bool alpha{false};
+
+    if (std::memcmp(d + 12, "VP8 ", 4) == 0)
+    {
+        if (d[23] != 0x9d || d[24] != 0x01 || d[25] != 0x2a)
+            return false;
+        w = le16(d + 26) & 0x3fff;
+        h = le16(d + 28) & 0x3fff;
+    }
+    else if (std::memcmp(d + 12, "VP8L", 4) == 0)
+    {
+        if (d[20] != 0x2f)
+            return false;
+        const std::uint32_t bits = le32(d + 21);
+        w = (bits & 0x3fff) + 1;
+        h = ((bits >> 14) & 0x3fff) + 1;
+        alpha = ((bits >> 28) & 1) != 0;
+    }
+    else if (std::memcmp(d + 12, "VP8X", 4) == 0)
+    {
+        alpha = (d[20] & 0x10) != 0;
+        w = le24(d + 24) + 1;
+        h = le24(d + 27) + 1;
+    }
+    else
+    {
+        return false;
+    }
+    if (!valid_size(w, h))
+        return false;
+
+    out = {"webp", static_cast<int>(w), static_cast<int>(h), alpha ? 4 : 3, CV_8U};
+    return true;
+}
+
+bool parse_image_header(const unsigned char *data, std::size_t size, ImageHeader &out)
+{
+    if (data == nullptr)
+        return false;
+
+    return parse_png(data, size, out) ||
+           parse_jpeg(data, size, out) ||
+           parse_tiff(data, size, out) ||
+           parse_bmp(data, size, out) ||
+           parse_webp(data, size, out);
+}
+
+cvtool::core::ExitCode probe_image_header(const std::string &path, ImageHeader &out, std::string &err)
+{
+    err.clear();
+
+    MappedFile mapped;
+    const auto map_code = mapped.open(path, err, false);
+    if (map_code != cvtool::core::ExitCode::Ok)
+        return map_code;
+
+    if (!parse_image_header(mapped.data(), mapped.size(), out))
+    {
+        err = fmt::format("error: no recognised image header: {}", path);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    return cvtool::core::ExitCode::Ok;
+}
+
+}
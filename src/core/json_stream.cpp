@@ -0,0 +1,116 @@
+#include "cvtool/core/json_stream.hpp"
+
+namespace cvtool::core
+{
+
+bool parse_json_layout(const std::string &name, JsonLayout &out)
+{
+    if (name == "pretty")
+        out = JsonLayout::Pretty;
+    else if (name == "compact")
+        out = JsonLayout::Compact;
+    else if (name == "ndjson")
+        out = JsonLayout::Ndjson;
+    else
+        return false;
+
+    return true;
+}
+
+JsonStreamWriter::JsonStreamWriter(std::ostream &out, JsonLayout layout)
+    : out_(out),
+      pretty_(layout == JsonLayout::Pretty)
+{
+}
+
+void JsonStreamWriter::newline_indent(std::size_t depth)
+{
+    out_ << '\n';
+    for (std::size_t i = 0; i < depth; i++)
+        out_ << "    ";
+}
+
+void JsonStreamWriter::before_value()
+{
+    if (after_key_)
+    {
+        after_key_ = false;
+        return;
+    }
+    if (scopes_.empty())
+        return;
+
+    Scope &scope = scopes_.back();
+    if (!scope.empty)
+        out_ << ',';
+    scope.empty = false;
+
+    if (pretty_)
+        newline_indent(scopes_.size());
+}
+
+void JsonStreamWriter::begin_object()
+{
+    before_value();
+    out_ << '{';
+    scopes_.push_back({false, true});
+}
+
+void JsonStreamWriter::end_object()
+{
+    const bool empty = scopes_.back().empty;
+    scopes_.pop_back();
+    if (pretty_ && !empty)
+        newline_indent(scopes_.size());
+    out_ << '}';
+}
+
+void JsonStreamWriter::begin_array()
+{
+    before_value();
+    out_ << '[';
+    scopes_.push_back({true, true});
+}
+
+void JsonStreamWriter::end_array()
+{
+    const bool empty = scopes_.back().empty;
+    scopes_.pop_back();
+    if (pretty_ && !empty)
+        newline_indent(scopes_.size());
+    out_ << ']';
+}
+
+void JsonStreamWriter::key(std::string_view name)
+{
+    before_value();
+    out_ << nlohmann::ordered_json(name).dump() << (pretty_ ? ": " : ":");
+    after_key_ = true;
+}
+
+void JsonStreamWriter::value(const nlohmann::ordered_json &v)
+{
+    before_value();
+    if (!pretty_)
+    {
+        out_ << v.dump();
+        return;
+    }
+
+    // Re-indent nested values to the current depth; string contents never hold raw newlines.
+    const std::string text = v.dump(4);
+    const std::string indent(scopes_.size() * 4, ' ');
+    for (const char c : text)
+    {
+        out_ << c;
+        if (c == '\n')
+            out_ << indent;
+    }
+}
+
+void JsonStreamWriter::end_document()
+{
+    out_ << '\n';
+}
+
+}
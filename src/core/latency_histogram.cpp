@@ -0,0 +1,82 @@
+#include "cvtool/core/latency_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace cvtool::core
+{
+
+int LatencyHistogram::index_of(std::uint64_t us)
+{
+    if (us < linear_count)
+        return static_cast<int>(us);
+
+    // Keep the top 6 bits: (us >> shift) lands in [32, 63].
+    const int shift = std::min(static_cast<int>(std::bit_width(us)) - 6, max_shift);
+    const auto sub = std::min<std::uint64_t>(us >> shift, 2 * sub_bucket_count - 1);
+    return linear_count + (shift - 1) * sub_bucket_count + static_cast<int>(sub - sub_bucket_count);
+}
+
+std::uint64_t LatencyHistogram::upper_bound_of(int index)
+{
+    if (index < linear_count)
+        return static_cast<std::uint64_t>(index);
+
+    const int shift = (index - linear_count) / sub_bucket_count + 1;
+    const auto sub = static_cast<std::uint64_t>((index - linear_count) % sub_bucket_count + sub_bucket_count);
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(double ms)
+{
+    if (!(ms >= 0.0))
+        ms = 0.0;
+
+    const auto us = static_cast<std::uint64_t>(std::llround(ms * 1000.0));
+    counts_[index_of(us)]++;
+
+    if (total_ == 0)
+    {
+        min_ms_ = ms;
+        max_ms_ = ms;
+    }
+    else
+    {
+        min_ms_ = std::min(min_ms_, ms);
+        max_ms_ = std::max(max_ms_, ms);
+    }
+    sum_ms_ += ms;
+    total_++;
+}
+
+void LatencyHistogram::reset()
+{
+    counts_.fill(0);
+    total_ = 0;
+    min_ms_ = 0.0;
+    max_ms_ = 0.0;
+    sum_ms_ = 0.0;
+}
+
+double LatencyHistogram::percentile_ms(double p) const
+{
+    if (total_ == 0)
+        return 0.0;
+
+    p = std::clamp(p, 0.0, 100.0);
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total_))));
+
+    std::uint64_t seen{0};
+    for (int i = 0; i < bucket_count; i++)
+    {
+        seen += counts_[i];
+        if (seen >= rank)
+            return std::clamp(upper_bound_of(i) / 1000.0, min_ms_, max_ms_);
+    }
+
+    return max_ms_;
+}
+
+}
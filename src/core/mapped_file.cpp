@@ -0,0 +1,159 @@
+#include "cvtool/core/mapped_file.hpp"
+
+#include <fmt/format.h>
+
+#include <filesystem>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cvtool::core
+{
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+cvtool::core::ExitCode MappedFile::open(const std::string &path, std::string &err, bool read_ahead)
+{
+    close();
+
+    const std::filesystem::path fs_path(path);
+    HANDLE file = CreateFileW(fs_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, read_ahead ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        err = fmt::format("error: cannot open file: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        err = fmt::format("error: file is empty or unreadable: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        err = fmt::format("error: cannot map file: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        err = fmt::format("error: cannot map file: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    mapping_ = mapping;
+    data_ = static_cast<const unsigned char *>(view);
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+    return cvtool::core::ExitCode::Ok;
+}
+
+void MappedFile::close()
+{
+    if (data_ != nullptr)
+        UnmapViewOfFile(data_);
+    if (mapping_ != nullptr)
+        CloseHandle(static_cast<HANDLE>(mapping_));
+
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+}
+
+void prefetch_file(const std::string &)
+{
+}
+
+#else
+
+cvtool::core::ExitCode MappedFile::open(const std::string &path, std::string &err, bool read_ahead)
+{
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        err = fmt::format("error: cannot open file: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        ::close(fd);
+        err = fmt::format("error: file is empty or unreadable: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void *view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (view == MAP_FAILED)
+    {
+        err = fmt::format("error: cannot map file: {}", path);
+        return cvtool::core::ExitCode::CannotOpenOrReadInput;
+    }
+
+    // Decoders read front to back: let the kernel read ahead aggressively.
+    if (read_ahead)
+    {
+        ::madvise(view, size, MADV_SEQUENTIAL);
+        ::madvise(view, size, MADV_WILLNEED);
+    }
+    else
+    {
+        ::madvise(view, size, MADV_RANDOM);
+    }
+
+    data_ = static_cast<const unsigned char *>(view);
+    size_ = size;
+    return cvtool::core::ExitCode::Ok;
+}
+
+void MappedFile::close()
+{
+    if (data_ != nullptr)
+        ::munmap(const_cast<unsigned char *>(data_), size_);
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void prefetch_file(const std::string &path)
+{
+#if defined(POSIX_FADV_WILLNEED)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    ::close(fd);
+#else
+    (void)path;
+#endif
+}
+
+#endif
+
+}
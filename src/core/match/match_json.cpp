@@ -1,8 +1,9 @@
 #include "cvtool/core/match/match_json.hpp"
 #include "cvtool/core/validate.hpp"
+#include "cvtool/core/json_stream.hpp"
 
 #include <nlohmann/json.hpp>
-#include <iomanip>
+
 #include <fstream>
 
 namespace cvtool::core::match_json
@@ -18,15 +19,14 @@ cvtool::core::ExitCode write_match_json(
     const std::string &roi_source,
     std::string &err)
 {
-    nlohmann::ordered_json j;
+    cvtool::core::JsonLayout layout{};
+    if (!cvtool::core::parse_json_layout(opt.json_format, layout))
+    {
+        err = "error: unknown json format: " + opt.json_format;
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
 
-    j["command"] = "match";
-    j["input"] = opt.in_path;
-    j["template"] = opt.templ_path;
-    j["output"] = opt.out_path;
-    j["params"] = {{"mode", opt.mode}, {"method", opt.method}, {"max_results", opt.max_results}, {"min_score", opt.min_score}, {"nms", opt.nms}, {"draw", opt.draw}, {"thickness", opt.thickness}, {"font_scale", opt.font_scale}};
-    j["template_size"] = {{"w", templ_size.width}, {"h", templ_size.height}};
-    j["scene_size"] = {{"w", scene_size.width}, {"h", scene_size.height}};
+    nlohmann::ordered_json params = {{"mode", opt.mode}, {"method", opt.method}, {"max_results", opt.max_results}, {"min_score", opt.min_score}, {"nms", opt.nms}, {"draw", opt.draw}, {"thickness", opt.thickness}, {"font_scale", opt.font_scale}};
 
     if (!opt.roi.empty())
     {
@@ -34,49 +34,108 @@ cvtool::core::ExitCode write_match_json(
         std::string err_dummy;
         if (cvtool::core::validate::validate_roi(opt.roi, r, err_dummy) == cvtool::core::ExitCode::Ok)
         {
-            j["params"]["roi"] = {{"x", r.x}, {"y", r.y}, {"w", r.width}, {"h", r.height}};
+            params["roi"] = {{"x", r.x}, {"y", r.y}, {"w", r.width}, {"h", r.height}};
         }
         else
         {
-            j["params"]["roi"] = nlohmann::ordered_json::object();
+            params["roi"] = nlohmann::ordered_json::object();
         }
     }
     else
     {
-        j["params"]["roi"] = nlohmann::ordered_json::object();
+        params["roi"] = nlohmann::ordered_json::object();
     }
 
-    j["roi_auto"] = opt.roi_auto;
-    j["roi_fallback"] = roi_fallback_used;
-    j["rois"] = nlohmann::json::array();
-    for (auto &r : rois)
+    std::ofstream file(opt.json_path);
+    if (!file)
     {
-        j["rois"].push_back({
-            {"x", r.x}, {"y", r.y}, {"w", r.width}, {"h", r.height}, {"source", roi_source}
-        });
+        err = "error: cannot open json output '" + opt.json_path + "'";
+        return cvtool::core::ExitCode::CannotWriteOutput;
     }
 
-    j["matches"] = nlohmann::json::array();
-    for (int i = 0; i < static_cast<int>(hits.size()); ++i)
+    // tagged: NDJSON lines carry their record type first.
+    const auto roi_json = [&](const cv::Rect &r, bool tagged)
+    {
+        nlohmann::ordered_json j = nlohmann::ordered_json::object();
+        if (tagged)
+            j["type"] = "roi";
+        j["x"] = r.x;
+        j["y"] = r.y;
+        j["w"] = r.width;
+        j["h"] = r.height;
+        j["source"] = roi_source;
+        return j;
+    };
+    const auto match_json = [&](int i, bool tagged)
     {
         const auto &h = hits[i];
-        j["matches"].push_back({{"id", i},
-                                {"bbox", {{"x", h.bbox.x}, {"y", h.bbox.y}, {"w", h.bbox.width}, {"h", h.bbox.height}}},
-                                {"raw_score", h.raw_score},
-                                {"confidence", h.confidence},
-                                {"scale", h.scale},
-                                {"template_size", {{"w", h.template_size.width}, {"h", h.template_size.height}}}});
-    }
-    j["stats"] = {{"found", (int)hits.size()}};
+        nlohmann::ordered_json j = nlohmann::ordered_json::object();
+        if (tagged)
+            j["type"] = "match";
+        j["id"] = i;
+        j["bbox"] = {{"x", h.bbox.x}, {"y", h.bbox.y}, {"w", h.bbox.width}, {"h", h.bbox.height}};
+        j["raw_score"] = h.raw_score;
+        j["confidence"] = h.confidence;
+        j["scale"] = h.scale;
+        j["template_size"] = {{"w", h.template_size.width}, {"h", h.template_size.height}};
+        return j;
+    };
 
-    std::ofstream file(opt.json_path);
-    if (!file)
+    cvtool::core::JsonStreamWriter w(file, layout);
+    w.begin_object();
+    w.field("command", "match");
+    w.field("input", opt.in_path);
+    w.field("template", opt.templ_path);
+    w.field("output", opt.out_path);
+    w.key("params");
+    w.value(params);
+    w.key("template_size");
+    w.value({{"w", templ_size.width}, {"h", templ_size.height}});
+    w.key("scene_size");
+    w.value({{"w", scene_size.width}, {"h", scene_size.height}});
+    w.field("roi_auto", opt.roi_auto);
+    w.field("roi_fallback", roi_fallback_used);
+
+    // NDJSON: the header (with stats) is the first line, then one tagged line per ROI and per match.
+    if (layout == cvtool::core::JsonLayout::Ndjson)
     {
-        err = "error: cannot open json output '" + opt.json_path + "'";
-        return cvtool::core::ExitCode::CannotWriteOutput;
+        w.key("stats");
+        w.value({{"found", (int)hits.size()}});
+        w.end_object();
+        w.end_document();
+
+        for (const auto &r : rois)
+        {
+            w.value(roi_json(r, true));
+            w.end_document();
+        }
+        for (int i = 0; i < static_cast<int>(hits.size()); ++i)
+        {
+            w.value(match_json(i, true));
+            w.end_document();
+        }
+    }
+    else
+    {
+        w.key("rois");
+        w.begin_array();
+        for (const auto &r : rois)
+            w.value(roi_json(r, false));
+        w.end_array();
+
+        w.key("matches");
+        w.begin_array();
+        for (int i = 0; i < static_cast<int>(hits.size()); ++i)
+            w.value(match_json(i, false));
+        w.end_array();
+
+        w.key("stats");
+        w.value({{"found", (int)hits.size()}});
+        w.end_object();
+        w.end_document();
     }
 
-    file << std::setw(4) << j << '\n';
+    file.flush();
     if (!file.good())
     {
         err = "error: failed to write json output: " + opt.json_path;
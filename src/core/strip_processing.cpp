@@ -0,0 +1,88 @@
+#include "cvtool/core/strip_processing.hpp"
+
+#include <opencv2/core.hpp>
+#include <opencv2/core/utility.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace cvtool::core
+{
+
+cvtool::core::ExitCode process_in_strips(
+    const cv::Mat &src,
+    cv::Mat &dst,
+    int dst_type,
+    int strip_rows,
+    int halo,
+    const StripFn &fn,
+    std::string &err)
+{
+    if (src.empty())
+    {
+        err = "error: input image is empty";
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+    if (strip_rows <= 0 || halo < 0)
+    {
+        err = fmt::format("error: invalid strip size ({} rows, halo {})", strip_rows, halo);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    dst.create(src.size(), dst_type);
+
+    const int strip_count = (src.rows + strip_rows - 1) / strip_rows;
+    std::mutex error_mutex;
+    std::string first_error;
+
+    // Exceptions must not escape a parallel_for_ body; the first one is reported after the loop.
+    cv::parallel_for_(cv::Range(0, strip_count), [&](const cv::Range &range)
+    {
+        for (int s = range.start; s < range.end; s++)
+        {
+            const int y0 = s * strip_rows;
+            const int y1 = std::min(y0 + strip_rows, src.rows);
+            const int top = std::max(y0 - halo, 0);
+            const int bottom = std::min(y1 + halo, src.rows);
+
+            try
+            {
+                // A clone, not a view: filters must see the strip's edge as an image border,
+                // never read past it into the parent image.
+                const cv::Mat region = src.rowRange(top, bottom).clone();
+                cv::Mat result;
+                fn(region, result);
+
+                if (result.rows != region.rows || result.cols != dst.cols || result.type() != dst_type)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (first_error.empty())
+                        first_error = "error: strip produced an unexpected result";
+                    return;
+                }
+
+                result.rowRange(y0 - top, y1 - top).copyTo(dst.rowRange(y0, y1));
+            }
+            catch (const cv::Exception &e)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (first_error.empty())
+                    first_error = fmt::format("error: strip processing failed ({})", e.what());
+                return;
+            }
+        }
+    });
+
+    if (!first_error.empty())
+    {
+        err = first_error;
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    err.clear();
+    return cvtool::core::ExitCode::Ok;
+}
+
+}
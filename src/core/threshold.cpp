@@ -7,11 +7,221 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace cvtool::core::threshold
+{
+
+std::vector<int> otsu_thresholds(const std::array<double, 256> &hist, int classes)
+{
+    // Maximizing the between-class variance is maximizing sum(S_k^2 / W_k)
+    // over contiguous ranges (W: weight, S: weighted sum), solved by dynamic
+    // programming over the range boundaries. Empty classes are not allowed.
+    std::array<double, 257> w{};
+    std::array<double, 257> s{};
+    for (int v = 0; v < 256; v++)
+    {
+        w[v + 1] = w[v] + hist[v];
+        s[v + 1] = s[v] + v * hist[v];
+    }
+
+    const auto cost = [&](int a, int b)
+    {
+        const double cw = w[b] - w[a];
+        const double cs = s[b] - s[a];
+        return cw > 0.0 ? cs * cs / cw : std::numeric_limits<double>::lowest();
+    };
+
+    // best[k][j]: classes 0..k cover values [0, j); from[k][j]: start of class k.
+    const double none = std::numeric_limits<double>::lowest();
+    std::vector<std::array<double, 257>> best(classes);
+    std::vector<std::array<int, 257>> from(classes);
+    for (int j = 0; j <= 256; j++)
+        best[0][j] = j > 0 ? cost(0, j) : none;
+
+    for (int k = 1; k < classes; k++)
+    {
+        best[k].fill(none);
+        for (int j = k + 1; j <= 256; j++)
+        {
+            for (int i = k; i < j; i++)
+            {
+                if (best[k - 1][i] == none)
+                    continue;
+                const double c = cost(i, j);
+                if (c == none)
+                    continue;
+                if (best[k - 1][i] + c > best[k][j])
+                {
+                    best[k][j] = best[k - 1][i] + c;
+                    from[k][j] = i;
+                }
+            }
+        }
+    }
+
+    // Fewer distinct values than classes: no valid split, all thresholds 0.
+    std::vector<int> thresholds(classes - 1, 0);
+    if (best[classes - 1][256] == none)
+        return thresholds;
+
+    int end = 256;
+    for (int k = classes - 1; k > 0; k--)
+    {
+        end = from[k][end];
+        thresholds[k - 1] = end - 1;
+    }
+    return thresholds;
+}
+
+void OtsuState::update(const Histogram &hist)
+{
+    std::uint64_t total{0};
+    for (const auto n : hist)
+        total += n;
+    if (total == 0)
+        return;
+
+    const double a = primed_ ? alpha_ : 1.0;
+    for (int v = 0; v < 256; v++)
+        hist_[v] = (1.0 - a) * hist_[v] + a * static_cast<double>(hist[v]) / static_cast<double>(total);
+    primed_ = true;
+}
+
+}
+
+// Histogram of every sample-th row and column of an 8-bit gray image, in
+// parallel over row bands.
+static void gray_histogram(const cv::Mat &gray, int sample, cvtool::core::threshold::Histogram &hist)
+{
+    hist.fill(0);
+    std::mutex merge;
+
+    cv::parallel_for_(cv::Range(0, (gray.rows + sample - 1) / sample), [&](const cv::Range &rows)
+    {
+        std::array<std::uint32_t, 256> local{};
+        for (int r = rows.start; r < rows.end; r++)
+        {
+            const uchar *p = gray.ptr<uchar>(r * sample);
+            for (int x = 0; x < gray.cols; x += sample)
+                local[p[x]]++;
+        }
+
+        std::lock_guard<std::mutex> lock(merge);
+        for (int v = 0; v < 256; v++)
+            hist[v] += local[v];
+    });
+}
+
+// 8-bit BGR/BGRA to gray with the histogram taken in the same pass: each band
+// of rows is converted and counted while it is still in cache.
+static void gray_and_histogram(const cv::Mat &src, cv::Mat &gray, int sample, cvtool::core::threshold::Histogram &hist)
+{
+    constexpr int band_rows = 32;
+
+    gray.create(src.size(), CV_8U);
+    hist.fill(0);
+    std::mutex merge;
+
+    const int code = src.channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY;
+    cv::parallel_for_(cv::Range(0, (src.rows + band_rows - 1) / band_rows), [&](const cv::Range &bands)
+    {
+        std::array<std::uint32_t, 256> local{};
+        for (int b = bands.start; b < bands.end; b++)
+        {
+            const int y0 = b * band_rows;
+            const int y1 = std::min(y0 + band_rows, src.rows);
+            cv::Mat dst = gray.rowRange(y0, y1);
+            cv::cvtColor(src.rowRange(y0, y1), dst, code);
+
+            for (int y = (y0 + sample - 1) / sample * sample; y < y1; y += sample)
+            {
+                const uchar *p = gray.ptr<uchar>(y);
+                for (int x = 0; x < gray.cols; x += sample)
+                    local[p[x]]++;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(merge);
+        for (int v = 0; v < 256; v++)
+            hist[v] += local[v];
+    });
+}
+
+enum class LocalThreshold
+{
+    MeanMinusC, // T = mean - c
+    Bradley,    // T = mean * (1 - p / 100)
+    Sauvola     // T = mean * (1 + k * (stddev / 128 - 1))
+};
+
+// Local statistics over a block x block window (clipped at the image border)
+// read from integral images: four lookups per pixel whatever the block size.
+static void integral_threshold(
+    const cv::Mat &gray, LocalThreshold kind, int block, double c, double k, double p, cv::Mat &bin)
+{
+    const bool sauvola = kind == LocalThreshold::Sauvola;
+    const double bradley_scale = 1.0 - p / 100.0;
+
+    cv::Mat sum, sqsum;
+    if (sauvola)
+        cv::integral(gray, sum, sqsum, CV_64F, CV_64F);
+    else
+        cv::integral(gray, sum, CV_64F);
+
+    bin.create(gray.size(), CV_8U);
+
+    const int r = block / 2;
+    const int w = gray.cols;
+    const int h = gray.rows;
+
+    cv::parallel_for_(cv::Range(0, h), [&](const cv::Range &rows)
+    {
+        for (int y = rows.start; y < rows.end; y++)
+        {
+            const int y0 = std::max(y - r, 0);
+            const int y1 = std::min(y + r + 1, h);
+            const double *s0 = sum.ptr<double>(y0);
+            const double *s1 = sum.ptr<double>(y1);
+            const double *q0 = sauvola ? sqsum.ptr<double>(y0) : nullptr;
+            const double *q1 = sauvola ? sqsum.ptr<double>(y1) : nullptr;
+            const uchar *g = gray.ptr<uchar>(y);
+            uchar *d = bin.ptr<uchar>(y);
+
+            for (int x = 0; x < w; x++)
+            {
+                const int x0 = std::max(x - r, 0);
+                const int x1 = std::min(x + r + 1, w);
+                const double area = static_cast<double>((x1 - x0) * (y1 - y0));
+                const double mean = (s1[x1] - s1[x0] - s0[x1] + s0[x0]) / area;
+
+                double thr = mean - c;
+                if (kind == LocalThreshold::Bradley)
+                {
+                    thr = mean * bradley_scale;
+                }
+                else if (sauvola)
+                {
+                    const double sq = (q1[x1] - q1[x0] - q0[x1] + q0[x0]) / area;
+                    const double stddev = std::sqrt(std::max(sq - mean * mean, 0.0));
+                    thr = mean * (1.0 + k * (stddev / 128.0 - 1.0));
+                }
+
+                d[x] = g[x] > thr ? 255 : 0;
+            }
+        }
+    });
+}
+
 
 cvtool::core::ExitCode make_binary_mask(
     const cv::Mat &src, 
     const std::string &mode, 
-    int blur_k, bool invert, int block, double c, int t, 
+    int blur_k, bool invert, int block, double c, double k, double p, int t, 
+    const cvtool::core::threshold::OtsuParams &otsu,
     cv::Mat &out_bin, std::string &err
 )
 {
@@ -37,7 +247,7 @@ cvtool::core::ExitCode make_binary_mask(
             return t_code;
         }
     }
-    else if (mode == "adaptive")
+    else if (mode == "adaptive" || mode == "adaptive-mean-fast" || mode == "bradley" || mode == "sauvola")
     {
         const auto b_code = cvtool::core::validate::validate_adaptive_block(block, err);
         if (b_code != cvtool::core::ExitCode::Ok)
@@ -47,10 +257,41 @@ cvtool::core::ExitCode make_binary_mask(
         }
     }
 
+    if (mode == "otsu" && (otsu.classes < 2 || otsu.classes > 5 || otsu.sample < 1))
+    {
+        err = fmt::format("error: invalid otsu parameters (classes 2..5, sample >= 1): {}, {}", otsu.classes, otsu.sample);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
+    if (mode == "sauvola")
+    {
+        const auto k_code = cvtool::core::validate::validate_01("k", k, err);
+        if (k_code != cvtool::core::ExitCode::Ok)
+        {
+            err = fmt::format("error: threshold parameter --k: {}", err);
+            return k_code;
+        }
+    }
+
+    if (mode == "bradley" && !(p >= 0.0 && p <= 100.0))
+    {
+        err = fmt::format("error: threshold parameter --p: must be in [0..100]: {}", p);
+        return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
+    }
+
     try
     {
+        // Otsu without pre-blur counts its histogram during the gray conversion.
+        const bool fused_otsu = mode == "otsu" && blur_k == 0 && src.depth() == CV_8U;
+        cvtool::core::threshold::Histogram hist{};
+
         cv::Mat gray;
-        if (src.channels() == 1){
+        if (fused_otsu && src.channels() == 1){
+            gray = src;
+            gray_histogram(gray, otsu.sample, hist);
+        } else if (fused_otsu){
+            gray_and_histogram(src, gray, otsu.sample, hist);
+        } else if (src.channels() == 1){
             gray = src.clone();
         } else if (src.channels() == 3){
             cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
@@ -78,7 +319,28 @@ cvtool::core::ExitCode make_binary_mask(
 
         if (mode == "otsu")
         {
-            cv::threshold(blur_used, bin, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+            if (!fused_otsu)
+                gray_histogram(blur_used, otsu.sample, hist);
+
+            std::vector<int> thresholds;
+            if (otsu.state != nullptr)
+            {
+                otsu.state->update(hist);
+                thresholds = otsu.state->thresholds(otsu.classes);
+            }
+            else
+            {
+                std::array<double, 256> h{};
+                for (int v = 0; v < 256; v++)
+                    h[v] = static_cast<double>(hist[v]);
+                thresholds = cvtool::core::threshold::otsu_thresholds(h, otsu.classes);
+            }
+
+            // One table lookup per pixel; the inversion is folded into the table.
+            cv::Mat lut(1, 256, CV_8U);
+            for (int v = 0; v < 256; v++)
+                lut.at<uchar>(v) = ((v > thresholds.back()) != invert) ? 255 : 0;
+            cv::LUT(blur_used, lut, bin);
         }
         else if (mode == "manual")
         {
@@ -88,18 +350,30 @@ cvtool::core::ExitCode make_binary_mask(
         {
             cv::adaptiveThreshold(blur_used, bin, 255, cv::ADAPTIVE_THRESH_GAUSSIAN_C, cv::THRESH_BINARY, block, c);
         }
+        else if (mode == "adaptive-mean-fast")
+        {
+            integral_threshold(blur_used, LocalThreshold::MeanMinusC, block, c, k, p, bin);
+        }
+        else if (mode == "bradley")
+        {
+            integral_threshold(blur_used, LocalThreshold::Bradley, block, c, k, p, bin);
+        }
+        else if (mode == "sauvola")
+        {
+            integral_threshold(blur_used, LocalThreshold::Sauvola, block, c, k, p, bin);
+        }
         else
         {
-            err = fmt::format("error: invalid --thresh (must be otsu|adaptive|manual): {}", mode);
+            err = fmt::format("error: invalid --thresh (must be otsu|adaptive|adaptive-mean-fast|bradley|sauvola|manual): {}", mode);
             return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
         }
         
-        if (invert)
+        if (invert && mode != "otsu")
             cv::bitwise_not(bin, bin);
         
         if (!bin.empty() && bin.channels() == 1 && bin.size()==blur_used.size())
         {
-            out_bin = bin.clone();
+            out_bin = bin;
             err.clear();
             return cvtool::core::ExitCode::Ok;
         }
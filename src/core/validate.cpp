@@ -85,13 +85,13 @@ cvtool::core::ExitCode validate_thresholds(int low, int high, std::string &err)
 
 cvtool::core::ExitCode validate_contours_thresh_mode(std::string_view mode, std::string &err)
 {
-    if (mode == "otsu" || mode == "adaptive" || mode == "manual")
+    if (mode == "otsu" || mode == "adaptive" || mode == "adaptive-mean-fast" || mode == "bradley" || mode == "sauvola" || mode == "manual")
     {
         err.clear();
         return cvtool::core::ExitCode::Ok;
     }
     
-    err = fmt::format("error: invalid --thresh (must be otsu|adaptive|manual): {}", mode);
+    err = fmt::format("error: invalid --thresh (must be otsu|adaptive|adaptive-mean-fast|bradley|sauvola|manual): {}", mode);
     return cvtool::core::ExitCode::InvalidParamsOrUnsupported;
 }
 
@@ -1,4 +1,7 @@
 #include "cvtool/core/exit_codes.hpp"
+#include "cvtool/core/batch_runner.hpp"
+#include "cvtool/core/threshold.hpp"
+#include "cvtool/core/gesture/preprocess_check.hpp"
 #include "cvtool/commands/info.hpp"
 #include "cvtool/commands/gray.hpp"
 #include "cvtool/commands/blur.hpp"
@@ -7,11 +10,17 @@
 #include "cvtool/commands/contours.hpp"
 #include "cvtool/commands/match.hpp"
 #include "cvtool/commands/gesture_show.hpp"
+#include "cvtool/commands/gesture_replay.hpp"
+#include "cvtool/commands/quantize_model.hpp"
+#include "cvtool/commands/threshold_bench.hpp"
 
 #include <CLI/CLI.hpp>
 
+#include <fmt/format.h>
+
 #include <filesystem>
 #include <limits>
+#include <memory>
 
 namespace Validators
 {
@@ -77,6 +86,36 @@ namespace Validators
         "OUT_DIR_EXISTS");
 }
 
+// --in-dir/--manifest/--out-dir run the command over many images; --in/--out stay for one image.
+static void add_batch_options(CLI::App *cmd, cvtool::core::BatchOptions &bo, CLI::Option *in, CLI::Option *out)
+{
+    auto *in_dir = cmd->add_option("--in-dir", bo.in_dir, "Batch: process every image below this folder")
+                       ->check(CLI::ExistingDirectory)->excludes(in);
+    cmd->add_option("--manifest", bo.manifest_path, "Batch: text file with one input path per line")
+        ->check(CLI::ExistingFile)->excludes(in)->excludes(in_dir);
+    cmd->add_option("--out-dir", bo.out_dir, "Batch: output folder (mirrors the input layout)")
+        ->excludes(out);
+    cmd->add_option("--out-ext", bo.out_ext, "Batch: output extension, e.g. .png (default: same as input)");
+    cmd->add_option("--jobs", bo.jobs, "Batch: worker threads (0 = all cores)")
+        ->check(CLI::Range(0, 1024))->default_val(0);
+    cmd->add_option("--checkpoint", bo.checkpoint_path, "Batch: file of finished inputs, skipped when the run is resumed");
+}
+
+static void require_in_out(const cvtool::core::BatchOptions &bo, const std::string &in, const std::string &out)
+{
+    if (bo.active())
+    {
+        if (bo.out_dir.empty())
+            throw CLI::RequiredError("--out-dir");
+        return;
+    }
+
+    if (in.empty())
+        throw CLI::RequiredError("--in");
+    if (out.empty())
+        throw CLI::RequiredError("--out");
+}
+
 int main(int argc, char **argv)
 {
     CLI::App app{"cvtool - console CV utility"};
@@ -91,36 +130,58 @@ int main(int argc, char **argv)
     auto *contours = app.add_subcommand("contours", "Threshold + contour detection + bboxes");
     auto *match = app.add_subcommand("match", "Temple matching (find pattern)");
     auto *gesture_show = app.add_subcommand("gesture-show", "Gesture recognition on a webcam");
+    auto *gesture_replay = app.add_subcommand(
+        "gesture-replay", "Replay a landmark recording through the gesture rules and stabilizer (no models)");
+    auto *quantize_model = app.add_subcommand(
+        "quantize-model", "Export INT8 calibration data and compare INT8 models against FP32");
+    auto *threshold_bench = app.add_subcommand(
+        "threshold-bench", "Time the adaptive threshold modes across block sizes");
+    // Hidden: parity check of the detector input packing against cv::dnn::blobFromImage.
+    auto *verify_preprocess = app.add_subcommand(
+        "verify-preprocess", "Check the detector input tensors against cv::dnn::blobFromImage")->group("");
 
     cvtool::cmd::InfoOptions inop;
     info->add_option("--in", inop.in_path, "Input file path")
         ->required()->check(CLI::ExistingFile);
+    info->add_flag("--json", inop.json, "Print a single-line JSON object");
 
     cvtool::cmd::GrayOptions grop;
-    gray->add_option("--in", grop.in_path, "Input file path")
-        ->required()->check(CLI::ExistingFile);
-    gray->add_option("--out", grop.out_path, "Output file path")
-        ->required()->check(Validators::out_path_exist);
+    auto *gray_in = gray->add_option("--in", grop.in_path, "Input file path")
+        ->check(CLI::ExistingFile);
+    auto *gray_out = gray->add_option("--out", grop.out_path, "Output file path")
+        ->check(Validators::out_path_exist);
+    gray->add_option("--strip-rows", grop.strip_rows, "Process in parallel strips of N rows; bit-exact, bounded working memory (0 = whole image)")
+        ->check(CLI::Range(0, std::numeric_limits<int>::max()))->default_val(0);
+    cvtool::core::BatchOptions gray_batch;
+    add_batch_options(gray, gray_batch, gray_in, gray_out);
 
     cvtool::cmd::BlurOptions blop;
-    blur->add_option("--in", blop.in_path, "Input file path")
-        ->required()->check(CLI::ExistingFile);
-    blur->add_option("--out", blop.out_path, "Output file path")
-        ->required()->check(Validators::out_path_exist);
+    auto *blur_in = blur->add_option("--in", blop.in_path, "Input file path")
+        ->check(CLI::ExistingFile);
+    auto *blur_out = blur->add_option("--out", blop.out_path, "Output file path")
+        ->check(Validators::out_path_exist);
     blur->add_option("--blur-k", blop.blur_k, "Blur coefficient (0 or odd >= 3)")
         ->required()->check(Validators::odd_or_zero);
+    blur->add_option("--strip-rows", blop.strip_rows, "Process in parallel strips of N rows; bit-exact, bounded working memory (0 = whole image)")
+        ->check(CLI::Range(0, std::numeric_limits<int>::max()))->default_val(0);
+    cvtool::core::BatchOptions blur_batch;
+    add_batch_options(blur, blur_batch, blur_in, blur_out);
 
     cvtool::cmd::EdgesOptions edop;
-    edges->add_option("--in", edop.in_path, "Input file path")
-         ->required()->check(CLI::ExistingFile);
-    edges->add_option("--out", edop.out_path, "Output file path")
-         ->required()->check(Validators::out_path_exist);
+    auto *edges_in = edges->add_option("--in", edop.in_path, "Input file path")
+         ->check(CLI::ExistingFile);
+    auto *edges_out = edges->add_option("--out", edop.out_path, "Output file path")
+         ->check(Validators::out_path_exist);
     edges->add_option("--blur-k", edop.blur_k, "Blur coefficient (0 or odd >= 3)")
          ->required()->check(Validators::odd_or_zero);
     edges->add_option("--low", edop.threshold_low, "Canny lower threshold (0-255)")
          ->required()->check(CLI::Range(0, 255));
     edges->add_option("--high", edop.threshold_high, "Canny upper threshold (0-255)")
          ->required()->check(CLI::Range(0, 255));
+    edges->add_option("--strip-rows", edop.strip_rows, "Process in parallel strips of N rows; bit-exact, bounded working memory (0 = whole image)")
+         ->check(CLI::Range(0, std::numeric_limits<int>::max()))->default_val(0);
+    cvtool::core::BatchOptions edges_batch;
+    add_batch_options(edges, edges_batch, edges_in, edges_out);
 
     cvtool::cmd::VideoEdgesOptions vept{};
     video_edges->add_option("--in", vept.in_path, "Input file path")
@@ -141,12 +202,12 @@ int main(int argc, char **argv)
                ->check(CLI::IsMember({"auto", "mp4v", "mjpg", "xvid"}));
 
     cvtool::cmd::ContoursOptions copt{};
-    contours->add_option("--in", copt.in_path, "Input image path")
-            ->required()->check(CLI::ExistingFile);
-    contours->add_option("--out", copt.out_path, "Output image path")
-            ->required()->check(Validators::out_path_exist);
-    contours->add_option("--thresh", copt.thresh, "otsu|adaptive|manual")
-            ->required()->check(CLI::IsMember({"otsu", "adaptive", "manual"}));
+    auto *contours_in = contours->add_option("--in", copt.in_path, "Input image path")
+            ->check(CLI::ExistingFile);
+    auto *contours_out = contours->add_option("--out", copt.out_path, "Output image path")
+            ->check(Validators::out_path_exist);
+    contours->add_option("--thresh", copt.thresh, "otsu|adaptive|adaptive-mean-fast|bradley|sauvola|manual")
+            ->required()->check(CLI::IsMember({"otsu", "adaptive", "adaptive-mean-fast", "bradley", "sauvola", "manual"}));
     contours->add_option("--blur-k", copt.blur_k, "0 or odd >= 3")
             ->required()->check(Validators::odd_or_zero);
     contours->add_option("--min-area", copt.min_area, "Min area (default: 100.0)")
@@ -157,10 +218,29 @@ int main(int argc, char **argv)
     contours->add_option("--block", copt.block, "Adaptive block (odd > 1)")
             ->check(Validators::odd_ge_3);
     contours->add_option("--c", copt.c, "Adaptive C");
+    contours->add_option("--k", copt.k, "Sauvola k (0..1)")
+            ->check(CLI::Range(0.0, 1.0));
+    contours->add_option("--p", copt.p, "Bradley percentage below the window mean (0..100)")
+            ->check(CLI::Range(0.0, 100.0));
+    contours->add_option("--otsu-classes", copt.otsu_classes, "Otsu classes (2..5); > 2 keeps the brightest class")
+            ->check(CLI::Range(2, 5))->default_val(2);
+    contours->add_option("--otsu-sample", copt.otsu_sample, "Otsu histogram from every N-th row and column")
+            ->check(CLI::Range(1, 64))->default_val(1);
+    contours->add_option("--otsu-smoothing", copt.otsu_smoothing,
+                         "Batch: carry the Otsu histogram across images, weight of each new image (0 = off)")
+            ->check(CLI::Range(0.0, 1.0))->default_val(0.0);
     contours->add_option("--t", copt.t, "Manual threshold 0..255")
             ->check(CLI::Range(0, 255));
     contours->add_option("--json-path", copt.json_path, "Optional JSON report path")
             ->check(Validators::out_path_exist);
+    contours->add_option("--json-format", copt.json_format, "JSON report layout: pretty|compact|ndjson")
+            ->check(CLI::IsMember({"pretty", "compact", "ndjson"}))->default_val("pretty");
+    contours->add_option("--bin", copt.bin_path, "Optional columnar binary report path (.cvcol)")
+            ->check(Validators::out_path_exist);
+    contours->add_flag("--stats-only", copt.stats_only,
+                       "Connected components only: pixel areas and bboxes, no contour polygons (faster)");
+    cvtool::core::BatchOptions contours_batch;
+    add_batch_options(contours, contours_batch, contours_in, contours_out);
 
     cvtool::cmd::MatchOptions mapt{};
     match->add_option("--in", mapt.in_path, "Input image path")
@@ -184,6 +264,10 @@ int main(int argc, char **argv)
          ->check(Validators::out_path_exist);
     match->add_option("--json", mapt.json_path, "Save JSON report")
          ->check(Validators::out_path_exist);
+    match->add_option("--json-format", mapt.json_format, "JSON report layout: pretty|compact|ndjson")
+         ->check(CLI::IsMember({"pretty", "compact", "ndjson"}))->default_val("pretty");
+    match->add_option("--bin", mapt.bin_path, "Save columnar binary report (.cvcol)")
+         ->check(Validators::out_path_exist);
     match->add_option("--roi", mapt.roi, "ROI: x, y, w, h");
     match->add_option("--draw", mapt.draw, "Draw: bbox|bbox+label|bbox+label+score")
          ->default_val("bbox+label+score");
@@ -221,39 +305,160 @@ int main(int argc, char **argv)
     cvtool::cmd::GestureShowOptions gsop;
     gesture_show->add_option("--cam", gsop.cam, "Camera device index (e.g. 0 for default)")
                 ->check(CLI::Range(0, std::numeric_limits<int>::max()))->default_val(0);
+    gesture_show->add_option("--in", gsop.in_path, "Read frames from a video file instead of the camera")
+                ->check(CLI::ExistingFile);
+    gesture_show->add_flag("--headless", gsop.headless,
+                "No windows; print one JSON line per frame and run as fast as possible");
+    gesture_show->add_option("--latency-out", gsop.latency_out_path,
+                "Write per-stage latency percentiles on exit (.json or .csv)");
+    gesture_show->add_option("--record", gsop.record_path,
+                "Record per-frame hand/face landmarks to a binary file for gesture-replay");
     gesture_show->add_option("--map", gsop.map_path, "Path to JSON with instructions")
                 ->required()->check(CLI::ExistingFile);
+    gesture_show->add_option("--rules", gsop.rules_path, "Path to JSON with gesture rules (replaces the built-in classifier)")
+                ->check(CLI::ExistingFile);
+    gesture_show->add_option("--bank-cache-mb", gsop.bank_cache_mb,
+                "Decode gesture images on first use and keep at most N MB of them (0 = preload all)")
+                ->check(CLI::Range(0, 65536))->default_val(0);
     gesture_show->add_option("--size", gsop.size_str, "Camera capture size WIDTHxHEIGHT (e.g. 800x600)");
     gesture_show->add_flag("--mirror", gsop.mirror, "Mirror camera, (default: false)");
     gesture_show->add_option("--roi", gsop.roi, "Region of interest: x,y,w,h");
     gesture_show->add_flag("--show-debug", gsop.show_debug, "Display debug overlays");
     gesture_show->add_option("--model", gsop.hand_model_path, "The path to a hand recognition model")
                 ->required()->check(CLI::ExistingFile);
+    gesture_show->add_option("--warmup", gsop.warmup_runs,
+                "Inference runs on dummy input per model at startup (0 = off)")
+                ->check(CLI::Range(0, 20))->default_val(2);
     gesture_show->add_option("--stable-frames", gsop.stable_frames, 
                 "How many consecutive frames the same gesture must appear to be considered stable")
                 ->check(CLI::Range(1, 100));
     gesture_show->add_option("--cooldown-ms", gsop.cooldown_ms, 
                 "Cooldown in milliseconds after a stable gesture change")
                 ->check(CLI::NonNegativeNumber);
+    gesture_show->add_option("--hand-interval", gsop.hand_interval,
+                "Run the hand model every N-th frame while a hand is tracked")
+                ->check(CLI::Range(1, 30))->default_val(2);
+    gesture_show->add_option("--max-hands", gsop.max_hands,
+                "Track up to N hands, each with its own gesture state (batched inference)")
+                ->check(CLI::Range(1, 4))->default_val(1);
+    gesture_show->add_option("--discovery-interval", gsop.discovery_interval,
+                "With --max-hands > 1: look for more hands every N inference frames while one is tracked")
+                ->check(CLI::Range(1, 1000))->default_val(10);
+    gesture_show->add_flag("--smooth", gsop.smooth,
+                "One-Euro landmark smoothing; skipped frames are classified from predicted landmarks");
+    gesture_show->add_option("--smooth-min-cutoff", gsop.smooth_min_cutoff,
+                "One-Euro minimum cutoff in Hz (lower = less jitter, more lag)")
+                ->check(CLI::Range(0.01, 100.0))->default_val(1.0);
+    gesture_show->add_option("--smooth-beta", gsop.smooth_beta,
+                "One-Euro speed coefficient (higher = less lag on fast motion)")
+                ->check(CLI::Range(0.0, 10.0))->default_val(0.05);
     gesture_show->add_option("--face-model", gsop.face_model_path, "Path to a face detection model")
                 ->check(CLI::ExistingFile);
     gesture_show->add_option("--face-conf", gsop.face_min_confidence, "Minimum face detection confidence")
                 ->check(CLI::Range(0.0, 1.0));
+    gesture_show->add_option("--face-input", gsop.face_input_size,
+                "Face detector input size (320|480|640); the frame is letterboxed to it")
+                ->check(CLI::IsMember({320, 480, 640}))->default_val(640);
     gesture_show->add_flag("--contextual-gestures", gsop.enable_contextual_gestures, 
                 "Enable contextual gesture filtering (requires face detection)");
 
+    cvtool::cmd::GestureReplayOptions grpop;
+    gesture_replay->add_option("--in", grpop.in_path, "Landmark recording written by gesture-show --record")
+                  ->required()->check(CLI::ExistingFile);
+    gesture_replay->add_option("--rules", grpop.rules_path, "Path to JSON with gesture rules (replaces the built-in classifier)")
+                  ->check(CLI::ExistingFile);
+    gesture_replay->add_flag("--contextual-gestures", grpop.enable_contextual_gestures,
+                  "Apply the contextual (face) gestures, as gesture-show --contextual-gestures");
+    gesture_replay->add_option("--stable-frames", grpop.stable_frames,
+                  "How many consecutive frames the same gesture must appear to be considered stable")
+                  ->check(CLI::Range(1, 100))->default_val(5);
+    gesture_replay->add_option("--cooldown-ms", grpop.cooldown_ms,
+                  "Cooldown in milliseconds after a stable gesture change")
+                  ->check(CLI::NonNegativeNumber)->default_val(300);
+    gesture_replay->add_option("--repeat", grpop.repeat, "Replay the recording N times (benchmarking)")
+                  ->check(CLI::Range(1, 1000000))->default_val(1);
+    gesture_replay->add_flag("--quiet", grpop.quiet, "Only print the summary, no per-frame JSON");
+
+    cvtool::cmd::ThresholdBenchOptions tbop;
+    threshold_bench->add_option("--in", tbop.in_path, "Input image path")
+                   ->required()->check(CLI::ExistingFile);
+    threshold_bench->add_option("--blocks", tbop.blocks, "Comma-separated block sizes (odd >= 3)")
+                   ->delimiter(',')->check(Validators::odd_ge_3);
+    threshold_bench->add_option("--c", tbop.c, "Adaptive C");
+    threshold_bench->add_option("--k", tbop.k, "Sauvola k (0..1)")
+                   ->check(CLI::Range(0.0, 1.0));
+    threshold_bench->add_option("--p", tbop.p, "Bradley percentage (0..100)")
+                   ->check(CLI::Range(0.0, 100.0));
+    threshold_bench->add_option("--repeat", tbop.repeat, "Timed runs per mode and block (median is reported)")
+                   ->check(CLI::Range(1, 1000))->default_val(5);
+
+    int verify_cases{200};
+    verify_preprocess->add_option("--cases", verify_cases, "Random crops to check")
+                     ->check(CLI::Range(1, 100000))->default_val(200);
+
+    cvtool::cmd::QuantizeModelOptions qmop;
+    quantize_model->add_option("--frames", qmop.frames_dir, "Folder with representative frames (.jpg/.png/.bmp)")
+                  ->required()->check(CLI::ExistingDirectory);
+    quantize_model->add_option("--out-dir", qmop.out_dir, "Output folder for calibration tensors and manifest")
+                  ->required();
+    quantize_model->add_option("--model", qmop.hand_model_path, "FP32 hand landmark model")
+                  ->required()->check(CLI::ExistingFile);
+    quantize_model->add_option("--face-model", qmop.face_model_path, "FP32 face detection model")
+                  ->check(CLI::ExistingFile);
+    quantize_model->add_option("--int8-model", qmop.int8_hand_model_path, "INT8 hand model to compare against FP32")
+                  ->check(CLI::ExistingFile);
+    quantize_model->add_option("--int8-face-model", qmop.int8_face_model_path,
+                  "INT8 face model to compare against FP32")
+                  ->check(CLI::ExistingFile);
+    quantize_model->add_option("--face-input", qmop.face_input_size, "Face detector input size (320|480|640)")
+                  ->check(CLI::IsMember({320, 480, 640}))->default_val(640);
+    quantize_model->add_option("--max-frames", qmop.max_frames, "Max calibration frames, spread over the folder (0=all)")
+                  ->check(CLI::Range(0, std::numeric_limits<int>::max()))->default_val(200);
+
     cvtool::core::ExitCode rc{0};
 
     info->callback([&]{ rc = run_info(inop); });
 
-    gray->callback([&]{ rc = run_gray(grop); });
+    gray->callback([&]{
+        require_in_out(gray_batch, grop.in_path, grop.out_path);
+        if (gray_batch.active()) {
+            rc = cvtool::core::run_batch("gray", gray_batch, [&](const std::string &in, const std::string &out) {
+                auto o = grop;
+                o.in_path = in;
+                o.out_path = out;
+                o.quiet = true;
+                return run_gray(o); });
+            return;
+        }
+        rc = run_gray(grop); });
 
-    blur->callback([&]{ rc = run_blur(blop); });
+    blur->callback([&]{
+        require_in_out(blur_batch, blop.in_path, blop.out_path);
+        if (blur_batch.active()) {
+            rc = cvtool::core::run_batch("blur", blur_batch, [&](const std::string &in, const std::string &out) {
+                auto o = blop;
+                o.in_path = in;
+                o.out_path = out;
+                o.quiet = true;
+                return run_blur(o); });
+            return;
+        }
+        rc = run_blur(blop); });
 
     edges->callback([&]{
         if(edop.threshold_low > edop.threshold_high) {
             throw CLI::ValidationError("--low", "must be < --high");
         }
+        require_in_out(edges_batch, edop.in_path, edop.out_path);
+        if (edges_batch.active()) {
+            rc = cvtool::core::run_batch("edges", edges_batch, [&](const std::string &in, const std::string &out) {
+                auto o = edop;
+                o.in_path = in;
+                o.out_path = out;
+                o.quiet = true;
+                return run_edges(o); });
+            return;
+        }
         rc = run_edges(edop); });
 
     video_edges->callback([&]{
@@ -262,12 +467,54 @@ int main(int argc, char **argv)
         }
         rc = run_video_edges(vept); });
 
-    contours->callback([&]{ rc = run_contours(copt); });
+    contours->callback([&]{
+        require_in_out(contours_batch, copt.in_path, copt.out_path);
+        if (contours_batch.active()) {
+            if (!copt.json_path.empty()) {
+                throw CLI::ValidationError("--json-path", "cannot be combined with --in-dir/--manifest");
+            }
+            if (!copt.bin_path.empty()) {
+                throw CLI::ValidationError("--bin", "cannot be combined with --in-dir/--manifest");
+            }
+            if (copt.otsu_smoothing > 0.0) {
+                if (contours_batch.jobs != 1) {
+                    throw CLI::ValidationError("--otsu-smoothing", "needs --jobs 1 (images must be processed in order)");
+                }
+                copt.otsu_state = std::make_shared<cvtool::core::threshold::OtsuState>(copt.otsu_smoothing);
+            }
+            rc = cvtool::core::run_batch("contours", contours_batch, [&](const std::string &in, const std::string &out) {
+                auto o = copt;
+                o.in_path = in;
+                o.out_path = out;
+                o.quiet = true;
+                return run_contours(o); });
+            return;
+        }
+        if (copt.otsu_smoothing > 0.0) {
+            throw CLI::ValidationError("--otsu-smoothing", "only applies to --in-dir/--manifest");
+        }
+        rc = run_contours(copt); });
 
     match->callback([&]{ rc = run_match(mapt); });
 
     gesture_show->callback([&]{ rc = run_gesture_show(gsop); });
 
+    gesture_replay->callback([&]{ rc = run_gesture_replay(grpop); });
+
+    quantize_model->callback([&]{ rc = run_quantize_model(qmop); });
+
+    threshold_bench->callback([&]{ rc = run_threshold_bench(tbop); });
+
+    verify_preprocess->callback([&]{
+        std::string report, err;
+        rc = cvtool::core::gesture::verify_preprocessing(verify_cases, report, err);
+        fmt::print("{}", report);
+        if (rc != cvtool::core::ExitCode::Ok) {
+            fmt::println(stderr, "{}", err);
+            return;
+        }
+        fmt::println("status: ok ({} cases bit-identical)", verify_cases); });
+
     try
     {
         app.parse(argc, argv);